@@ -790,6 +790,7 @@ unsigned section_header_only : 1;
 unsigned flush_context_pending : 1;
 unsigned parallel_enabled : 1;
 unsigned parallel_was_enabled : 1;
+unsigned int pack_threads;      /* threads packing value changes, 0 or 1 = serial */
 
 /* should really be semaphores, but are bytes to cut down on read-modify-write window size */
 unsigned char already_in_flush; /* in case control-c handlers interrupt */
@@ -1266,6 +1267,302 @@ if(xc)
  * only to be called directly by fst code...otherwise must
  * be synced up with time changes
  */
+/*
+ * builds the value changes of one handle backwards into the end of
+ * scratchpad, returns the start and sets *wrlen_out to the length
+ */
+static unsigned char *fstWriterBuildValueChanges(struct fstWriterContext *xc, uint32_t *vm4ip, uint32_t offs, unsigned char *scratchpad, unsigned int *wrlen_out)
+{
+unsigned char *vchg_mem = xc->vchg_mem;
+unsigned char *scratchpnt = scratchpad + xc->vchg_siz;
+uint32_t next_offs;
+unsigned int wrlen;
+
+if(vm4ip[1] <= 1)
+        {
+        if(vm4ip[1] == 1)
+                {
+                wrlen = fstGetVarint32Length(vchg_mem + offs + 4); /* used to advance and determine wrlen */
+#ifndef FST_REMOVE_DUPLICATE_VC
+                xc->curval_mem[vm4ip[0]] = vchg_mem[offs + 4 + wrlen]; /* checkpoint variable */
+#endif
+                while(offs)
+                        {
+                        unsigned char val;
+                        uint32_t time_delta, rcv;
+                        next_offs = fstGetUint32(vchg_mem + offs);
+                        offs += 4;
+
+                        time_delta = fstGetVarint32(vchg_mem + offs, (int *)&wrlen);
+                        val = vchg_mem[offs+wrlen];
+                        offs = next_offs;
+
+                        switch(val)
+                                {
+                                case '0':
+                                case '1':               rcv = ((val&1)<<1) | (time_delta<<2);
+                                                        break; /* pack more delta bits in for 0/1 vchs */
+
+                                case 'x': case 'X':     rcv = FST_RCV_X | (time_delta<<4); break;
+                                case 'z': case 'Z':     rcv = FST_RCV_Z | (time_delta<<4); break;
+                                case 'h': case 'H':     rcv = FST_RCV_H | (time_delta<<4); break;
+                                case 'u': case 'U':     rcv = FST_RCV_U | (time_delta<<4); break;
+                                case 'w': case 'W':     rcv = FST_RCV_W | (time_delta<<4); break;
+                                case 'l': case 'L':     rcv = FST_RCV_L | (time_delta<<4); break;
+                                default:                rcv = FST_RCV_D | (time_delta<<4); break;
+                                }
+
+                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, rcv);
+                        }
+                }
+                else
+                {
+                /* variable length */
+                /* fstGetUint32 (next_offs) + fstGetVarint32 (time_delta) + fstGetVarint32 (len) + payload */
+                unsigned char *pnt;
+                uint32_t record_len;
+                uint32_t time_delta;
+
+                while(offs)
+                        {
+                        next_offs = fstGetUint32(vchg_mem + offs);
+                        offs += 4;
+                        pnt = vchg_mem + offs;
+                        offs = next_offs;
+                        time_delta = fstGetVarint32(pnt, (int *)&wrlen);
+                        pnt += wrlen;
+                        record_len = fstGetVarint32(pnt, (int *)&wrlen);
+                        pnt += wrlen;
+
+                        scratchpnt -= record_len;
+                        memcpy(scratchpnt, pnt, record_len);
+
+                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, record_len);
+                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, (time_delta << 1)); /* reserve | 1 case for future expansion */
+                        }
+                }
+        }
+        else
+        {
+        wrlen = fstGetVarint32Length(vchg_mem + offs + 4); /* used to advance and determine wrlen */
+#ifndef FST_REMOVE_DUPLICATE_VC
+        memcpy(xc->curval_mem + vm4ip[0], vchg_mem + offs + 4 + wrlen, vm4ip[1]); /* checkpoint variable */
+#endif
+        while(offs)
+                {
+                unsigned int idx;
+                char is_binary = 1;
+                unsigned char *pnt;
+                uint32_t time_delta;
+
+                next_offs = fstGetUint32(vchg_mem + offs);
+                offs += 4;
+
+                time_delta = fstGetVarint32(vchg_mem + offs, (int *)&wrlen);
+
+                pnt = vchg_mem+offs+wrlen;
+                offs = next_offs;
+
+                for(idx=0;idx<vm4ip[1];idx++)
+                        {
+                        if((pnt[idx] == '0') || (pnt[idx] == '1'))
+                                {
+                                continue;
+                                }
+                                else
+                                {
+                                is_binary = 0;
+                                break;
+                                }
+                        }
+
+                if(is_binary)
+                        {
+                        unsigned char acc = 0;
+                        /* new algorithm */
+                        idx = ((vm4ip[1]+7) & ~7);
+                        switch(vm4ip[1] & 7)
+                                {
+                                case 0: do {    acc  = (pnt[idx+7-8] & 1) << 0; /* fallthrough */
+                                case 7:         acc |= (pnt[idx+6-8] & 1) << 1; /* fallthrough */
+                                case 6:         acc |= (pnt[idx+5-8] & 1) << 2; /* fallthrough */
+                                case 5:         acc |= (pnt[idx+4-8] & 1) << 3; /* fallthrough */
+                                case 4:         acc |= (pnt[idx+3-8] & 1) << 4; /* fallthrough */
+                                case 3:         acc |= (pnt[idx+2-8] & 1) << 5; /* fallthrough */
+                                case 2:         acc |= (pnt[idx+1-8] & 1) << 6; /* fallthrough */
+                                case 1:         acc |= (pnt[idx+0-8] & 1) << 7;
+                                                *(--scratchpnt) = acc;
+                                                idx -= 8;
+                                        } while(idx);
+                                }
+
+                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, (time_delta << 1));
+                        }
+                        else
+                        {
+                        scratchpnt -= vm4ip[1];
+                        memcpy(scratchpnt, pnt, vm4ip[1]);
+
+                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, (time_delta << 1) | 1);
+                        }
+                }
+        }
+
+
+*wrlen_out = scratchpad + xc->vchg_siz - scratchpnt;
+return(scratchpnt);
+}
+
+
+/*
+ * compresses the value changes of one handle, returns the data to write
+ * and sets *destlen_out to its length, and *unclen_out to the length to
+ * write before it (the uncompressed length, or 0 if stored uncompressed)
+ */
+static unsigned char *fstWriterPackValueChanges(struct fstWriterContext *xc, unsigned char *scratchpnt, unsigned int wrlen,
+        unsigned char **packmem, unsigned int *packmemlen, unsigned int *destlen_out, unsigned int *unclen_out)
+{
+if(wrlen > 32)
+        {
+        unsigned long destlen = wrlen;
+        unsigned char *dmem;
+        unsigned int rc;
+
+        if(!xc->fastpack)
+                {
+                if(wrlen <= *packmemlen)
+                        {
+                        dmem = *packmem;
+                        }
+                        else
+                        {
+                        free(*packmem);
+                        dmem = *packmem = (unsigned char *)malloc(compressBound(*packmemlen = wrlen));
+                        }
+
+                rc = compress2(dmem, &destlen, scratchpnt, wrlen, 4);
+                if(rc == Z_OK)
+                        {
+                        *destlen_out = destlen;
+                        *unclen_out = wrlen;
+                        return(dmem);
+                        }
+                }
+                else
+                {
+                /* this is extremely conservative: fastlz needs +5% for worst case, lz4 needs siz+(siz/255)+16 */
+                if(((wrlen * 2) + 2) <= *packmemlen)
+                        {
+                        dmem = *packmem;
+                        }
+                        else
+                        {
+                        free(*packmem);
+                        dmem = *packmem = (unsigned char *)malloc(*packmemlen = (wrlen * 2) + 2);
+                        }
+
+                rc = (xc->fourpack) ? LZ4_compress((char *)scratchpnt, (char *)dmem, wrlen) : fastlz_compress(scratchpnt, wrlen, dmem);
+                if(rc < destlen)
+                        {
+                        *destlen_out = rc;
+                        *unclen_out = wrlen;
+                        return(dmem);
+                        }
+                }
+        }
+
+*destlen_out = wrlen;
+*unclen_out = 0;
+return(scratchpnt);
+}
+
+
+#ifdef FST_WRITER_PARALLEL
+#define FST_PACK_CHUNK 256      /* handles claimed at a time by a pack thread */
+
+struct fstWriterPackResult      /* packed value changes of one handle */
+{
+size_t offs;                    /* offset of the data in the arena of its job */
+uint32_t destlen;               /* length of the data */
+uint32_t unclen;                /* length to write before the data, 0 if uncompressed */
+uint32_t wrlen;                 /* length before packing */
+uint32_t job;                   /* job that packed it */
+};
+
+struct fstWriterPackJob
+{
+struct fstWriterContext *xc;
+struct fstWriterPackResult *results;
+pthread_mutex_t *mutex;
+unsigned int *next_handle;
+unsigned char *arena;           /* packed data of this job */
+size_t arena_siz;
+size_t arena_len;
+uint32_t id;
+int threaded;                   /* has its own thread to join */
+};
+
+
+/*
+ * packs chunks of handles until none are left, the value changes of each
+ * handle are independent so any number of these may run at once
+ */
+static void *fstWriterPackJobRun(void *ctx)
+{
+struct fstWriterPackJob *job = (struct fstWriterPackJob *)ctx;
+struct fstWriterContext *xc = job->xc;
+unsigned char *scratchpad = (unsigned char *)malloc(xc->vchg_siz);
+unsigned int packmemlen = 1024;
+unsigned char *packmem = (unsigned char *)malloc(packmemlen);
+
+for(;;)
+        {
+        unsigned int i, first, last;
+
+        pthread_mutex_lock(job->mutex);
+        first = *job->next_handle;
+        if(first < xc->maxhandle) *job->next_handle += FST_PACK_CHUNK;
+        pthread_mutex_unlock(job->mutex);
+
+        if(first >= xc->maxhandle) break;
+        last = (xc->maxhandle - first > FST_PACK_CHUNK) ? (first + FST_PACK_CHUNK) : xc->maxhandle;
+
+        for(i=first;i<last;i++)
+                {
+                uint32_t *vm4ip = &(xc->valpos_mem[4*i]);
+
+                if(vm4ip[2])
+                        {
+                        struct fstWriterPackResult *res = &job->results[i];
+                        unsigned char *scratchpnt, *dmem;
+                        unsigned int wrlen, destlen, unclen;
+
+                        scratchpnt = fstWriterBuildValueChanges(xc, vm4ip, vm4ip[2], scratchpad, &wrlen);
+                        dmem = fstWriterPackValueChanges(xc, scratchpnt, wrlen, &packmem, &packmemlen, &destlen, &unclen);
+
+                        if((job->arena_len + destlen) > job->arena_siz)
+                                {
+                                job->arena_siz = (job->arena_len + destlen) * 2;
+                                job->arena = (unsigned char *)realloc(job->arena, job->arena_siz);
+                                }
+                        memcpy(job->arena + job->arena_len, dmem, destlen);
+
+                        res->offs = job->arena_len;
+                        res->destlen = destlen;
+                        res->unclen = unclen;
+                        res->wrlen = wrlen;
+                        res->job = job->id;
+                        job->arena_len += destlen;
+                        }
+                }
+        }
+
+free(packmem);
+free(scratchpad);
+return(NULL);
+}
+#endif
+
 #ifdef FST_WRITER_PARALLEL
 static void fstWriterFlushContextPrivate2(void *ctx)
 #else
@@ -1276,7 +1573,6 @@ static void fstWriterFlushContextPrivate(void *ctx)
 int cnt = 0;
 #endif
 unsigned int i;
-unsigned char *vchg_mem;
 FILE *f;
 fst_off_t fpos, indxpos, endpos;
 uint32_t prevpos;
@@ -1296,6 +1592,12 @@ struct fstWriterContext *xc2 = xc->xc_parent;
 struct fstWriterContext *xc2 = xc;
 #endif
 
+#ifdef FST_WRITER_PARALLEL
+struct fstWriterPackResult *pack_results = NULL;
+struct fstWriterPackJob *pack_jobs = NULL;
+unsigned int pack_jobcnt = 0;
+#endif
+
 #ifndef FST_DYNAMIC_ALIAS_DISABLE
 Pvoid_t PJHSArray = (Pvoid_t) NULL;
 #ifndef _WAVE_HAVE_JUDY
@@ -1314,8 +1616,6 @@ xc->already_in_flush = 1; /* should really do this with a semaphore */
 xc->section_header_only = 0;
 scratchpad = (unsigned char *)malloc(xc->vchg_siz);
 
-vchg_mem = xc->vchg_mem;
-
 f = xc->handle;
 fstWriterVarint(f, xc->maxhandle);      /* emit current number of handles */
 fputc(xc->fourpack ? '4' : (xc->fastpack ? 'F' : 'Z'), f);
@@ -1324,287 +1624,90 @@ fpos = 1;
 packmemlen = 1024;                      /* maintain a running "longest" allocation to */
 packmem = (unsigned char *)malloc(packmemlen);           /* prevent continual malloc...free every loop iter */
 
+#ifdef FST_WRITER_PARALLEL
+if((xc->pack_threads > 1) && (xc->maxhandle > FST_PACK_CHUNK))
+        {
+        /* pack the handles in parallel, then write them in order below */
+        pthread_t *pack_tids;
+        pthread_mutex_t pack_mutex;
+        unsigned int next_handle = 0;
+
+        pack_jobcnt = xc->pack_threads;
+        pack_results = (struct fstWriterPackResult *)malloc(xc->maxhandle * sizeof(struct fstWriterPackResult));
+        pack_jobs = (struct fstWriterPackJob *)calloc(pack_jobcnt, sizeof(struct fstWriterPackJob));
+        pack_tids = (pthread_t *)malloc(pack_jobcnt * sizeof(pthread_t));
+        pthread_mutex_init(&pack_mutex, NULL);
+
+        for(i=0;i<pack_jobcnt;i++)
+                {
+                pack_jobs[i].xc = xc;
+                pack_jobs[i].results = pack_results;
+                pack_jobs[i].mutex = &pack_mutex;
+                pack_jobs[i].next_handle = &next_handle;
+                pack_jobs[i].id = i;
+                if(i)
+                        {
+                        pack_jobs[i].threaded = !pthread_create(&pack_tids[i], NULL, fstWriterPackJobRun, &pack_jobs[i]);
+                        /* could not create the thread, pack here instead */
+                        if(!pack_jobs[i].threaded) fstWriterPackJobRun(&pack_jobs[i]);
+                        }
+                }
+        fstWriterPackJobRun(&pack_jobs[0]);     /* this thread packs too */
+        for(i=1;i<pack_jobcnt;i++)
+                {
+                if(pack_jobs[i].threaded) pthread_join(pack_tids[i], NULL);
+                }
+
+        pthread_mutex_destroy(&pack_mutex);
+        free(pack_tids);
+        }
+#endif
+
 for(i=0;i<xc->maxhandle;i++)
         {
         vm4ip = &(xc->valpos_mem[4*i]);
 
         if(vm4ip[2])
                 {
-                uint32_t offs = vm4ip[2];
-                uint32_t next_offs;
-                unsigned int wrlen;
+                unsigned int wrlen, destlen, unclen;
+                unsigned char *dmem;
 
-                vm4ip[2] = fpos;
-
-                scratchpnt = scratchpad + xc->vchg_siz;         /* build this buffer backwards */
-                if(vm4ip[1] <= 1)
+#ifdef FST_WRITER_PARALLEL
+                if(pack_results)
                         {
-                        if(vm4ip[1] == 1)
-                                {
-                                wrlen = fstGetVarint32Length(vchg_mem + offs + 4); /* used to advance and determine wrlen */
-#ifndef FST_REMOVE_DUPLICATE_VC
-                                xc->curval_mem[vm4ip[0]] = vchg_mem[offs + 4 + wrlen]; /* checkpoint variable */
-#endif
-                                while(offs)
-                                        {
-                                        unsigned char val;
-                                        uint32_t time_delta, rcv;
-                                        next_offs = fstGetUint32(vchg_mem + offs);
-                                        offs += 4;
-
-                                        time_delta = fstGetVarint32(vchg_mem + offs, (int *)&wrlen);
-                                        val = vchg_mem[offs+wrlen];
-                                        offs = next_offs;
-
-                                        switch(val)
-                                                {
-                                                case '0':
-                                                case '1':               rcv = ((val&1)<<1) | (time_delta<<2);
-                                                                        break; /* pack more delta bits in for 0/1 vchs */
-
-                                                case 'x': case 'X':     rcv = FST_RCV_X | (time_delta<<4); break;
-                                                case 'z': case 'Z':     rcv = FST_RCV_Z | (time_delta<<4); break;
-                                                case 'h': case 'H':     rcv = FST_RCV_H | (time_delta<<4); break;
-                                                case 'u': case 'U':     rcv = FST_RCV_U | (time_delta<<4); break;
-                                                case 'w': case 'W':     rcv = FST_RCV_W | (time_delta<<4); break;
-                                                case 'l': case 'L':     rcv = FST_RCV_L | (time_delta<<4); break;
-                                                default:                rcv = FST_RCV_D | (time_delta<<4); break;
-                                                }
-
-                                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, rcv);
-                                        }
-                                }
-                                else
-                                {
-                                /* variable length */
-                                /* fstGetUint32 (next_offs) + fstGetVarint32 (time_delta) + fstGetVarint32 (len) + payload */
-                                unsigned char *pnt;
-                                uint32_t record_len;
-                                uint32_t time_delta;
-
-                                while(offs)
-                                        {
-                                        next_offs = fstGetUint32(vchg_mem + offs);
-                                        offs += 4;
-                                        pnt = vchg_mem + offs;
-                                        offs = next_offs;
-                                        time_delta = fstGetVarint32(pnt, (int *)&wrlen);
-                                        pnt += wrlen;
-                                        record_len = fstGetVarint32(pnt, (int *)&wrlen);
-                                        pnt += wrlen;
-
-                                        scratchpnt -= record_len;
-                                        memcpy(scratchpnt, pnt, record_len);
-
-                                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, record_len);
-                                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, (time_delta << 1)); /* reserve | 1 case for future expansion */
-                                        }
-                                }
+                        struct fstWriterPackResult *res = &pack_results[i];
+                        dmem = pack_jobs[res->job].arena + res->offs;
+                        wrlen = res->wrlen;
+                        destlen = res->destlen;
+                        unclen = res->unclen;
                         }
                         else
-                        {
-                        wrlen = fstGetVarint32Length(vchg_mem + offs + 4); /* used to advance and determine wrlen */
-#ifndef FST_REMOVE_DUPLICATE_VC
-                        memcpy(xc->curval_mem + vm4ip[0], vchg_mem + offs + 4 + wrlen, vm4ip[1]); /* checkpoint variable */
 #endif
-                        while(offs)
-                                {
-                                unsigned int idx;
-                                char is_binary = 1;
-                                unsigned char *pnt;
-                                uint32_t time_delta;
-
-                                next_offs = fstGetUint32(vchg_mem + offs);
-                                offs += 4;
-
-                                time_delta = fstGetVarint32(vchg_mem + offs, (int *)&wrlen);
-
-                                pnt = vchg_mem+offs+wrlen;
-                                offs = next_offs;
-
-                                for(idx=0;idx<vm4ip[1];idx++)
-                                        {
-                                        if((pnt[idx] == '0') || (pnt[idx] == '1'))
-                                                {
-                                                continue;
-                                                }
-                                                else
-                                                {
-                                                is_binary = 0;
-                                                break;
-                                                }
-                                        }
-
-                                if(is_binary)
-                                        {
-                                        unsigned char acc = 0;
-                                        /* new algorithm */
-                                        idx = ((vm4ip[1]+7) & ~7);
-                                        switch(vm4ip[1] & 7)
-                                                {
-                                                case 0: do {    acc  = (pnt[idx+7-8] & 1) << 0; /* fallthrough */
-                                                case 7:         acc |= (pnt[idx+6-8] & 1) << 1; /* fallthrough */
-                                                case 6:         acc |= (pnt[idx+5-8] & 1) << 2; /* fallthrough */
-                                                case 5:         acc |= (pnt[idx+4-8] & 1) << 3; /* fallthrough */
-                                                case 4:         acc |= (pnt[idx+3-8] & 1) << 4; /* fallthrough */
-                                                case 3:         acc |= (pnt[idx+2-8] & 1) << 5; /* fallthrough */
-                                                case 2:         acc |= (pnt[idx+1-8] & 1) << 6; /* fallthrough */
-                                                case 1:         acc |= (pnt[idx+0-8] & 1) << 7;
-                                                                *(--scratchpnt) = acc;
-                                                                idx -= 8;
-                                                        } while(idx);
-                                                }
-
-                                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, (time_delta << 1));
-                                        }
-                                        else
-                                        {
-                                        scratchpnt -= vm4ip[1];
-                                        memcpy(scratchpnt, pnt, vm4ip[1]);
-
-                                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, (time_delta << 1) | 1);
-                                        }
-                                }
+                        {
+                        scratchpnt = fstWriterBuildValueChanges(xc, vm4ip, vm4ip[2], scratchpad, &wrlen);
+                        dmem = fstWriterPackValueChanges(xc, scratchpnt, wrlen, &packmem, &packmemlen, &destlen, &unclen);
                         }
 
-                wrlen = scratchpad + xc->vchg_siz - scratchpnt;
+                vm4ip[2] = fpos;
                 unc_memreq += wrlen;
-                if(wrlen > 32)
-                        {
-                        unsigned long destlen = wrlen;
-                        unsigned char *dmem;
-                        unsigned int rc;
-
-                        if(!xc->fastpack)
-                                {
-                                if(wrlen <= packmemlen)
-                                        {
-                                        dmem = packmem;
-                                        }
-                                        else
-                                        {
-                                        free(packmem);
-                                        dmem = packmem = (unsigned char *)malloc(compressBound(packmemlen = wrlen));
-                                        }
-
-                                rc = compress2(dmem, &destlen, scratchpnt, wrlen, 4);
-                                if(rc == Z_OK)
-                                        {
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                                        PPvoid_t pv = JudyHSIns(&PJHSArray, dmem, destlen, NULL);
-                                        if(*pv)
-                                                {
-                                                uint32_t pvi = (intptr_t)(*pv);
-                                                vm4ip[2] = -pvi;
-                                                }
-                                                else
-                                                {
-                                                *pv = (void *)(intptr_t)(i+1);
-#endif
-                                                fpos += fstWriterVarint(f, wrlen);
-                                                fpos += destlen;
-                                                fstFwrite(dmem, destlen, 1, f);
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                                                }
-#endif
-                                        }
-                                        else
-                                        {
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                                        PPvoid_t pv = JudyHSIns(&PJHSArray, scratchpnt, wrlen, NULL);
-                                        if(*pv)
-                                                {
-                                                uint32_t pvi = (intptr_t)(*pv);
-                                                vm4ip[2] = -pvi;
-                                                }
-                                                else
-                                                {
-                                                *pv = (void *)(intptr_t)(i+1);
-#endif
-                                                fpos += fstWriterVarint(f, 0);
-                                                fpos += wrlen;
-                                                fstFwrite(scratchpnt, wrlen, 1, f);
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                                                }
-#endif
-                                        }
-                                }
-                                else
-                                {
-                                /* this is extremely conservative: fastlz needs +5% for worst case, lz4 needs siz+(siz/255)+16 */
-                                if(((wrlen * 2) + 2) <= packmemlen)
-                                        {
-                                        dmem = packmem;
-                                        }
-                                        else
-                                        {
-                                        free(packmem);
-                                        dmem = packmem = (unsigned char *)malloc(packmemlen = (wrlen * 2) + 2);
-                                        }
 
-                                rc = (xc->fourpack) ? LZ4_compress((char *)scratchpnt, (char *)dmem, wrlen) : fastlz_compress(scratchpnt, wrlen, dmem);
-                                if(rc < destlen)
-                                        {
 #ifndef FST_DYNAMIC_ALIAS_DISABLE
-                                        PPvoid_t pv = JudyHSIns(&PJHSArray, dmem, rc, NULL);
-                                        if(*pv)
-                                                {
-                                                uint32_t pvi = (intptr_t)(*pv);
-                                                vm4ip[2] = -pvi;
-                                                }
-                                                else
-                                                {
-                                                *pv = (void *)(intptr_t)(i+1);
-#endif
-                                                fpos += fstWriterVarint(f, wrlen);
-                                                fpos += rc;
-                                                fstFwrite(dmem, rc, 1, f);
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                                                }
-#endif
-                                        }
-                                        else
-                                        {
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                                        PPvoid_t pv = JudyHSIns(&PJHSArray, scratchpnt, wrlen, NULL);
-                                        if(*pv)
-                                                {
-                                                uint32_t pvi = (intptr_t)(*pv);
-                                                vm4ip[2] = -pvi;
-                                                }
-                                                else
-                                                {
-                                                *pv = (void *)(intptr_t)(i+1);
-#endif
-                                                fpos += fstWriterVarint(f, 0);
-                                                fpos += wrlen;
-                                                fstFwrite(scratchpnt, wrlen, 1, f);
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                                                }
-#endif
-                                        }
-                                }
+                PPvoid_t pv = JudyHSIns(&PJHSArray, dmem, destlen, NULL);
+                if(*pv)
+                        {
+                        uint32_t pvi = (intptr_t)(*pv);
+                        vm4ip[2] = -pvi;
                         }
                         else
                         {
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                        PPvoid_t pv = JudyHSIns(&PJHSArray, scratchpnt, wrlen, NULL);
-                        if(*pv)
-                                {
-                                uint32_t pvi = (intptr_t)(*pv);
-                                vm4ip[2] = -pvi;
-                                }
-                                else
-                                {
-                                *pv = (void *)(intptr_t)(i+1);
+                        *pv = (void *)(intptr_t)(i+1);
 #endif
-                                fpos += fstWriterVarint(f, 0);
-                                fpos += wrlen;
-                                fstFwrite(scratchpnt, wrlen, 1, f);
+                        fpos += fstWriterVarint(f, unclen);
+                        fpos += destlen;
+                        fstFwrite(dmem, destlen, 1, f);
 #ifndef FST_DYNAMIC_ALIAS_DISABLE
-                                }
-#endif
                         }
+#endif
 
                 /* vm4ip[3] = 0; ...redundant with clearing below */
 #ifdef FST_DEBUG
@@ -1613,6 +1716,18 @@ for(i=0;i<xc->maxhandle;i++)
                 }
         }
 
+#ifdef FST_WRITER_PARALLEL
+if(pack_results)
+        {
+        for(i=0;i<pack_jobcnt;i++)
+                {
+                free(pack_jobs[i].arena);
+                }
+        free(pack_jobs); pack_jobs = NULL;
+        free(pack_results); pack_results = NULL;
+        }
+#endif
+
 #ifndef FST_DYNAMIC_ALIAS_DISABLE
 JudyHSFreeArray(&PJHSArray, NULL);
 #endif
@@ -2536,6 +2651,20 @@ if(xc)
 }
 
 
+void fstWriterSetPackThreads(void *ctx, int threads)
+{
+struct fstWriterContext *xc = (struct fstWriterContext *)ctx;
+if(xc)
+        {
+#ifdef FST_WRITER_PARALLEL
+        xc->pack_threads = (threads > 1) ? threads : 1;
+#else
+        (void)threads;          /* packing is always serial without FST_WRITER_PARALLEL */
+#endif
+        }
+}
+
+
 void fstWriterSetRepackOnClose(void *ctx, int enable)
 {
 struct fstWriterContext *xc = (struct fstWriterContext *)ctx;
@@ -135,7 +135,7 @@ void vl_stop(const char* filename, int linenum, const char* hier) VL_MT_UNSAFE {
         } else {
             VL_PRINTF("%%Error: %s\n", msg);
         }
-        Verilated::runFlushCallbacks();
+        Verilated::runDumpFlushCallbacks();
     }
 }
 #endif
@@ -151,7 +151,7 @@ void vl_fatal(const char* filename, int linenum, const char* hier, const char* m
     } else {
         VL_PRINTF("%%Error: %s\n", msg);
     }
-    Verilated::runFlushCallbacks();
+    Verilated::runDumpFlushCallbacks();
 
     VL_PRINTF("Aborting...\n");  // Not VL_PRINTF_MT, already on main thread
 
@@ -2556,6 +2556,43 @@ void VerilatedContext::threads(unsigned n) {
     }
 }
 
+void VerilatedContext::threadsShared(bool flag) {
+    if (m_threadPool) {
+        VL_FATAL_MT(__FILE__, __LINE__, "",
+                    "%Error: Cannot set shared simulation threads after the thread pool has "
+                    "been created.");
+    }
+    m_threadsShared = flag;
+}
+
+std::string VerilatedContext::threadsAffinity() const VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    return m_ns.m_threadsAffinity;
+}
+void VerilatedContext::threadsAffinity(const std::string& cpus) {
+    if (m_threadPool) {
+        VL_FATAL_MT(__FILE__, __LINE__, "",
+                    "%Error: Cannot set simulation thread affinity after the thread pool has "
+                    "been created.");
+    }
+    if (cpus != "numa" && cpus.find_first_not_of("0123456789,-") != std::string::npos) {
+        const std::string msg = "Unknown +verilator+threads+affinity+ value: '" + cpus
+                                + "', suggest a CPU list such as '0-3,8', or 'numa'";
+        VL_FATAL_MT("COMMAND_LINE", 0, "", msg.c_str());
+    }
+    const VerilatedLockGuard lock{m_mutex};
+    m_ns.m_threadsAffinity = cpus;
+}
+
+void VerilatedContext::threadsWait(VerilatedThreadsWait policy) VL_MT_SAFE {
+    m_ns.m_threadsWait.store(policy, std::memory_order_relaxed);
+}
+
+const char* VerilatedContext::threadsWaitName(VerilatedThreadsWait policy) VL_PURE {
+    static const char* const s_names[] = {"spin-yield", "spin", "park", "adaptive"};
+    return s_names[static_cast<size_t>(policy)];
+}
+
 void VerilatedContext::commandArgs(int argc, const char** argv) VL_MT_SAFE_EXCLUDES(m_argMutex) {
     // Not locking m_argMutex here, it is done in impp()->commandArgsAddGuts
     // m_argMutex here is the same as in impp()->commandArgsAddGuts;
@@ -2604,7 +2641,7 @@ void VerilatedContext::addModel(VerilatedModel* modelp) {
 
 VerilatedVirtualBase* VerilatedContext::threadPoolp() {
     if (m_threads == 1) return nullptr;
-    if (!m_threadPool) m_threadPool.reset(new VlThreadPool{this, m_threads - 1});
+    if (!m_threadPool) m_threadPool.reset(new VlThreadPool{this, m_threads - 1, m_threadsShared});
     return m_threadPool.get();
 }
 
@@ -2718,6 +2755,24 @@ void VerilatedContextImp::commandArgVl(const std::string& arg) {
         } else if (commandArgVlUint64(arg, "+verilator+seed+", u64, 1,
                                       std::numeric_limits<int>::max())) {
             randSeed(static_cast<int>(u64));
+        } else if (commandArgVlString(arg, "+verilator+threads+affinity+", str)) {
+            threadsAffinity(str);
+        } else if (arg == "+verilator+threads+shared") {
+            threadsShared(true);
+        } else if (commandArgVlString(arg, "+verilator+threads+wait+", str)) {
+            bool found = false;
+            for (int i = 0; i < static_cast<int>(VerilatedThreadsWait::_ENUM_END); ++i) {
+                const VerilatedThreadsWait policy = static_cast<VerilatedThreadsWait>(i);
+                if (str == threadsWaitName(policy)) {
+                    threadsWait(policy);
+                    found = true;
+                }
+            }
+            if (!found) {
+                const std::string msg = "Unknown +verilator+threads+wait+ policy: '" + str
+                                        + "', suggest 'spin-yield', 'spin', 'park' or 'adaptive'";
+                VL_FATAL_MT("COMMAND_LINE", 0, "", msg.c_str());
+            }
         } else if (arg == "+verilator+V") {
             VerilatedImp::versionDump();  // Someday more info too
             VL_FATAL_MT("COMMAND_LINE", 0, "",
@@ -2880,7 +2935,7 @@ const char* Verilated::catName(const char* n1, const char* n2, const char* delim
 }
 
 //=========================================================================
-// Flush and exit callbacks
+// Flush, dump flush and exit callbacks
 
 // Keeping these out of class Verilated to avoid having to include <list>
 // in verilated.h (for compilation speed)
@@ -2888,6 +2943,8 @@ using VoidPCbList = std::list<std::pair<Verilated::VoidPCb, void*>>;
 static struct {
     VerilatedMutex s_flushMutex;
     VoidPCbList s_flushCbs VL_GUARDED_BY(s_flushMutex);
+    VerilatedMutex s_dumpFlushMutex;
+    VoidPCbList s_dumpFlushCbs VL_GUARDED_BY(s_dumpFlushMutex);
     VerilatedMutex s_exitMutex;
     VoidPCbList s_exitCbs VL_GUARDED_BY(s_exitMutex);
 } VlCbStatic;
@@ -2899,6 +2956,13 @@ static void addCbFlush(Verilated::VoidPCb cb, void* datap)
     VlCbStatic.s_flushCbs.remove(pair);  // Just in case it's a duplicate
     VlCbStatic.s_flushCbs.push_back(pair);
 }
+static void addCbDumpFlush(Verilated::VoidPCb cb, void* datap)
+    VL_MT_SAFE_EXCLUDES(VlCbStatic.s_dumpFlushMutex) {
+    const VerilatedLockGuard lock{VlCbStatic.s_dumpFlushMutex};
+    std::pair<Verilated::VoidPCb, void*> pair(cb, datap);
+    VlCbStatic.s_dumpFlushCbs.remove(pair);  // Just in case it's a duplicate
+    VlCbStatic.s_dumpFlushCbs.push_back(pair);
+}
 static void addCbExit(Verilated::VoidPCb cb, void* datap)
     VL_MT_SAFE_EXCLUDES(VlCbStatic.s_exitMutex) {
     const VerilatedLockGuard lock{VlCbStatic.s_exitMutex};
@@ -2912,6 +2976,12 @@ static void removeCbFlush(Verilated::VoidPCb cb, void* datap)
     std::pair<Verilated::VoidPCb, void*> pair(cb, datap);
     VlCbStatic.s_flushCbs.remove(pair);
 }
+static void removeCbDumpFlush(Verilated::VoidPCb cb, void* datap)
+    VL_MT_SAFE_EXCLUDES(VlCbStatic.s_dumpFlushMutex) {
+    const VerilatedLockGuard lock{VlCbStatic.s_dumpFlushMutex};
+    std::pair<Verilated::VoidPCb, void*> pair(cb, datap);
+    VlCbStatic.s_dumpFlushCbs.remove(pair);
+}
 static void removeCbExit(Verilated::VoidPCb cb, void* datap)
     VL_MT_SAFE_EXCLUDES(VlCbStatic.s_exitMutex) {
     const VerilatedLockGuard lock{VlCbStatic.s_exitMutex};
@@ -2940,6 +3010,22 @@ void Verilated::runFlushCallbacks() VL_MT_SAFE {
     VL_GCOV_DUMP();
 }
 
+void Verilated::addDumpFlushCb(VoidPCb cb, void* datap) VL_MT_SAFE {
+    addCbDumpFlush(cb, datap);
+}
+void Verilated::removeDumpFlushCb(VoidPCb cb, void* datap) VL_MT_SAFE {
+    removeCbDumpFlush(cb, datap);
+}
+void Verilated::runDumpFlushCallbacks() VL_MT_SAFE {
+    static std::atomic<int> s_recursing;
+    if (!s_recursing++) {
+        const VerilatedLockGuard lock{VlCbStatic.s_dumpFlushMutex};
+        runCallbacks(VlCbStatic.s_dumpFlushCbs);
+    }
+    --s_recursing;
+    runFlushCallbacks();
+}
+
 void Verilated::addExitCb(VoidPCb cb, void* datap) VL_MT_SAFE { addCbExit(cb, datap); }
 void Verilated::removeExitCb(VoidPCb cb, void* datap) VL_MT_SAFE { removeCbExit(cb, datap); }
 void Verilated::runExitCallbacks() VL_MT_SAFE {
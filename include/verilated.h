@@ -149,6 +149,16 @@ enum VerilatedVarFlags {
     VLVF_DPI_CLAY = (1 << 10)  // DPI compatible C standard layout
 };
 
+/// How threads of multithreaded models wait for the MTasks they depend on,
+/// see VerilatedContext::threadsWait()
+enum class VerilatedThreadsWait : uint8_t {
+    SPIN_YIELD = 0,  ///< Spin, periodically yielding the CPU (default)
+    SPIN,  ///< Only spin; lowest latency when each thread has a dedicated core
+    PARK,  ///< Spin for a while, then sleep until woken; for oversubscribed machines
+    ADAPTIVE,  ///< Spin for a learned per-dependency time, then sleep until woken
+    _ENUM_END
+};
+
 //=============================================================================
 // Utility functions
 
@@ -381,9 +391,12 @@ protected:
         // Fast path
         uint64_t m_profExecStart = 1;  // +prof+exec+start time
         uint32_t m_profExecWindow = 2;  // +prof+exec+window size
+        // +threads+wait, read by waiting threads while it might be set
+        std::atomic<VerilatedThreadsWait> m_threadsWait{VerilatedThreadsWait::SPIN_YIELD};
         // Slow path
         std::string m_profExecFilename;  // +prof+exec+file filename
         std::string m_profVltFilename;  // +prof+vlt filename
+        std::string m_threadsAffinity;  // +threads+affinity CPU list
     } m_ns;
 
     mutable VerilatedMutex m_argMutex;  // Protect m_argVec, m_argVecLoaded
@@ -399,6 +412,8 @@ protected:
     const std::unique_ptr<VerilatedContextImpData> m_impdatap;
     // Number of threads to use for simulation (size of m_threadPool + 1 for main thread)
     unsigned m_threads = std::thread::hardware_concurrency();
+    // Thread pool uses process-wide threads shared with other contexts
+    bool m_threadsShared = false;
     // The thread pool shared by all models added to this context
     std::unique_ptr<VerilatedVirtualBase> m_threadPool;
     // The execution profiler shared by all models added to this context
@@ -542,6 +557,34 @@ public:
     /// Can only be called before the thread pool is created (before first model is added).
     void threads(unsigned n);
 
+    /// Get whether simulation threads are shared with other contexts
+    bool threadsShared() const { return m_threadsShared; }
+    /// Set whether simulation threads are shared with other contexts. When
+    /// set, the threads come from a single process-wide set, used by all
+    /// contexts that set this, and threads() becomes this context's quota of
+    /// them. This allows running many contexts without oversubscribing the
+    /// machine. Can only be called before the thread pool is created.
+    void threadsShared(bool flag);
+    /// Get CPUs simulation threads are pinned to, see threadsAffinity(const std::string&)
+    std::string threadsAffinity() const VL_MT_SAFE;
+    /// Set CPUs simulation threads are pinned to. Empty for no pinning (the
+    /// default), a CPU list such as "0-3,8" assigning thread N (0 being the
+    /// thread that creates the thread pool) to the Nth CPU of the list, or
+    /// "numa" to choose CPUs close to the creating thread's NUMA node.
+    /// Can only be called before the thread pool is created (before first model is added).
+    void threadsAffinity(const std::string& cpus);
+
+    /// Get how threads wait for MTask dependencies of multithreaded models
+    VerilatedThreadsWait threadsWait() const VL_MT_SAFE {
+        return m_ns.m_threadsWait.load(std::memory_order_relaxed);
+    }
+    /// Set how threads wait for MTask dependencies of multithreaded models.
+    /// Applies to the threads of the thread pool, and to threads evaluating
+    /// models of this context.
+    void threadsWait(VerilatedThreadsWait policy) VL_MT_SAFE;
+    /// Return name of wait policy, as used with +verilator+threads+wait+<name>
+    static const char* threadsWaitName(VerilatedThreadsWait policy) VL_PURE;
+
     /// Allow traces to at some point be enabled (disables some optimizations)
     void traceEverOn(bool flag) VL_MT_SAFE {
         if (flag) calcUnusedSigs(true);
@@ -833,7 +876,7 @@ public:
     }
 #endif
 
-    /// Callback typedef for addFlushCb, addExitCb
+    /// Callback typedef for addFlushCb, addDumpFlushCb, addExitCb
     using VoidPCb = void (*)(void*);
     /// Add callback to run on global flush
     static void addFlushCb(VoidPCb cb, void* datap) VL_MT_SAFE;
@@ -844,6 +887,13 @@ public:
 #ifndef VL_NO_LEGACY
     static void flushCall() VL_MT_SAFE { runFlushCallbacks(); }  // Deprecated
 #endif
+    /// Add callback to run on $dumpflush, $stop and $fatal, before the flush
+    /// callbacks (used to write trace flight recordings)
+    static void addDumpFlushCb(VoidPCb cb, void* datap) VL_MT_SAFE;
+    /// Remove callback to run on $dumpflush, $stop and $fatal
+    static void removeDumpFlushCb(VoidPCb cb, void* datap) VL_MT_SAFE;
+    /// Run callbacks registered with addDumpFlushCb, then the flush callbacks
+    static void runDumpFlushCallbacks() VL_MT_SAFE;
     /// Add callback to run prior to exit termination
     static void addExitCb(VoidPCb cb, void* datap) VL_MT_SAFE;
     /// Remove callback to run prior to exit termination
@@ -0,0 +1,261 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// Code available from: https://verilator.org
+//
+// Copyright 2023 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//=============================================================================
+///
+/// \file
+/// \brief Convert a binary trace written with --trace-bin to FST
+///
+/// This is a standalone program, built and run by
+/// "verilator_trace_convert --fst", which writes the FST file through the
+/// GTKWave FST writer used by VerilatedFst. It is not linked into
+/// Verilated models.
+///
+//=============================================================================
+
+// clang-format off
+
+#include "verilatedos.h"
+
+// GTKWave configuration
+#define HAVE_LIBPTHREAD
+#define FST_WRITER_PARALLEL
+
+// Include the GTKWave implementation directly
+#define FST_CONFIG_INCLUDE "fst_config.h"
+#include "gtkwave/fastlz.c"
+#include "gtkwave/fstapi.c"
+#include "gtkwave/lz4.c"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// clang-format on
+
+namespace {
+
+constexpr size_t VL_TRACE_BIN_BLOCK_HEADER_SIZE = 8;  // Block type, 3 reserved, 32 bit size
+constexpr char VL_TRACE_BIN_MAGIC[] = "VLTBIN01";
+
+// A signal, as declared in the header of the binary trace
+struct Signal final {
+    char m_kind = 0;  // 'w' bit, 'v' vector, 'r' real, 'e' event
+    int m_bits = 0;  // Width
+    uint32_t m_bytes = 0;  // Bytes of each value in the binary trace
+    fstHandle m_handle = 0;  // FST handle, 0 if not yet declared
+};
+
+// A declaration, sorted by hierarchical name as VerilatedVcd does
+struct Decl final {
+    uint32_t m_code;  // Signal code
+    std::string m_name;  // Name within its scope, with array index and range
+};
+
+[[noreturn]] void fatal(const std::string& msg) {
+    std::fprintf(stderr, "%%Error: %s\n", msg.c_str());
+    std::exit(1);
+}
+
+uint64_t readLE(const unsigned char* p, uint32_t bytes) {
+    uint64_t value = 0;
+    for (uint32_t i = bytes; i > 0; --i) value = (value << 8) | p[i - 1];
+    return value;
+}
+
+// Parse the header text, declaring all signals in the FST file
+void declare(void* fstp, const std::string& header, std::vector<Signal>& signals) {
+    std::map<std::string, Decl> decls;
+    std::istringstream is{header};
+    std::string line;
+    while (std::getline(is, line)) {
+        if (line.compare(0, 10, "timescale ") == 0) {
+            fstWriterSetTimescaleFromString(fstp, line.c_str() + 10);
+            continue;
+        }
+        if (line.compare(0, 4, "var ") != 0) continue;
+        // var <code> <kind> <bits> <msb> <lsb> <arraynum>\t<scopes>\t<name>
+        const size_t tab = line.find('\t');
+        if (tab == std::string::npos) fatal("Malformed declaration: " + line);
+        std::istringstream fields{line.substr(4, tab - 4)};
+        uint32_t code;
+        char kind;
+        int bits, msb, lsb, arraynum;
+        if (!(fields >> code >> kind >> bits >> msb >> lsb >> arraynum)) {
+            fatal("Malformed declaration: " + line);
+        }
+        if (code >= signals.size()) signals.resize(code + 1);
+        Signal& sig = signals[code];
+        sig.m_kind = kind;
+        sig.m_bits = bits;
+        sig.m_bytes = kind == 'e' ? 0 : kind == 'r' ? 8 : (bits + 7) / 8;
+
+        std::string hiername = line.substr(tab + 1);
+        std::string name = hiername.substr(hiername.rfind('\t') + 1);
+        if (arraynum != -1) {
+            name += "[" + std::to_string(arraynum) + "]";
+            hiername += "[" + std::to_string(arraynum) + "]";
+        }
+        if (kind == 'v') name += " [" + std::to_string(msb) + ":" + std::to_string(lsb) + "]";
+        decls.emplace(hiername, Decl{code, name});
+    }
+
+    // As in VerilatedVcd, signals must be under a module
+    bool rootSignals = false;
+    for (const auto& pair : decls) rootSignals |= pair.first[0] == '\t';
+    if (rootSignals) {
+        std::map<std::string, Decl> topDecls;
+        for (const auto& pair : decls) {
+            topDecls.emplace((pair.first[0] == '\t' ? "top" : "top ") + pair.first, pair.second);
+        }
+        decls.swap(topDecls);
+    }
+
+    std::vector<std::string> curScope;
+    for (const auto& pair : decls) {
+        // Scopes are separated by spaces, and by a tab from the signal name
+        const std::string& hiername = pair.first;
+        std::vector<std::string> scope;
+        std::istringstream scopes{hiername.substr(0, hiername.rfind('\t'))};
+        std::string name;
+        while (std::getline(scopes, name, ' ')) {
+            if (!name.empty()) scope.push_back(name);
+        }
+        size_t common = 0;
+        while (common < curScope.size() && common < scope.size()
+               && curScope[common] == scope[common]) {
+            ++common;
+        }
+        for (size_t i = common; i < curScope.size(); ++i) fstWriterSetUpscope(fstp);
+        for (size_t i = common; i < scope.size(); ++i) {
+            fstWriterSetScope(fstp, FST_ST_VCD_SCOPE, scope[i].c_str(), nullptr);
+        }
+        curScope = scope;
+
+        const Decl& decl = pair.second;
+        Signal& sig = signals[decl.m_code];
+        const fstVarType type = sig.m_kind == 'e'   ? FST_VT_VCD_EVENT
+                                : sig.m_kind == 'r' ? FST_VT_VCD_REAL
+                                                    : FST_VT_VCD_WIRE;
+        // The first declaration of a code creates the signal, the others alias it
+        const fstHandle handle = fstWriterCreateVar(fstp, type, FST_VD_IMPLICIT, sig.m_bits,
+                                                    decl.m_name.c_str(), sig.m_handle);
+        if (!sig.m_handle) sig.m_handle = handle;
+    }
+    for (size_t i = 0; i < curScope.size(); ++i) fstWriterSetUpscope(fstp);
+}
+
+// Emit the value changes of one data block
+void convertBlock(void* fstp, const unsigned char* p, const unsigned char* endp,
+                  const std::vector<Signal>& signals, uint64_t& time, bool& timeValid) {
+    std::vector<char> bits;
+    while (p < endp) {
+        // LEB128 varint code
+        uint32_t code = 0;
+        for (int shift = 0;; shift += 7) {
+            if (p >= endp) fatal("Truncated value change");
+            const unsigned char byte = *p++;
+            code |= static_cast<uint32_t>(byte & 0x7f) << shift;
+            if (byte < 0x80) break;
+        }
+        if (code == 0) {
+            if (endp - p < 8) fatal("Truncated time change");
+            const uint64_t newTime = readLE(p, 8);
+            p += 8;
+            // Each block restates the time, only emit when it moved
+            if (!timeValid || newTime != time) fstWriterEmitTimeChange(fstp, newTime);
+            time = newTime;
+            timeValid = true;
+            continue;
+        }
+        if (code >= signals.size() || !signals[code].m_kind) {
+            fatal("Value change for undeclared code " + std::to_string(code));
+        }
+        const Signal& sig = signals[code];
+        if (static_cast<size_t>(endp - p) < sig.m_bytes) fatal("Truncated value change");
+        switch (sig.m_kind) {
+        case 'e': fstWriterEmitValueChange(fstp, sig.m_handle, "1"); break;
+        case 'r': {
+            double value;
+            std::memcpy(&value, p, sizeof(value));
+            fstWriterEmitValueChange(fstp, sig.m_handle, &value);
+            break;
+        }
+        default:
+            // Least significant byte first, FST wants most significant bit first
+            bits.resize(sig.m_bits);
+            for (int bit = 0; bit < sig.m_bits; ++bit) {
+                bits[sig.m_bits - 1 - bit] = '0' + ((p[bit / 8] >> (bit % 8)) & 1);
+            }
+            fstWriterEmitValueChange(fstp, sig.m_handle, bits.data());
+            break;
+        }
+        p += sig.m_bytes;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) fatal("Usage: verilated_bin2fst <input.bin> <output.fst>");
+    const char* const inFilename = argv[1];
+    const char* const outFilename = argv[2];
+
+    std::ifstream ifs{inFilename, std::ios::binary};
+    if (!ifs) fatal(std::string{"Cannot open "} + inFilename);
+    const std::vector<unsigned char> data{std::istreambuf_iterator<char>{ifs},
+                                          std::istreambuf_iterator<char>{}};
+    const size_t magicSize = std::strlen(VL_TRACE_BIN_MAGIC);
+    if (data.size() < magicSize || std::memcmp(data.data(), VL_TRACE_BIN_MAGIC, magicSize)) {
+        fatal(std::string{inFilename} + ": Not a Verilator binary trace file");
+    }
+
+    void* const fstp = fstWriterCreate(outFilename, 1);
+    if (!fstp) fatal(std::string{"Cannot write "} + outFilename);
+    fstWriterSetPackType(fstp, FST_WR_PT_LZ4);
+
+    // The header blocks all precede the data blocks
+    std::string header;
+    std::vector<Signal> signals;
+    bool declared = false;
+    uint64_t time = 0;
+    bool timeValid = false;
+    size_t pos = magicSize;
+    while (pos + VL_TRACE_BIN_BLOCK_HEADER_SIZE <= data.size()) {
+        const unsigned char type = data[pos];
+        const size_t size = readLE(&data[pos + 4], 4);
+        pos += VL_TRACE_BIN_BLOCK_HEADER_SIZE;
+        if (pos + size > data.size()) {
+            // Simulation ended before the block was completely written
+            std::fprintf(stderr, "%%Warning: %s: Ignoring truncated block at end of file\n",
+                         inFilename);
+            break;
+        }
+        if (type == 'H') {
+            header.append(reinterpret_cast<const char*>(&data[pos]), size);
+        } else if (type == 'D') {
+            if (!declared) {
+                declare(fstp, header, signals);
+                declared = true;
+            }
+            convertBlock(fstp, &data[pos], &data[pos + size], signals, time, timeValid);
+        }
+        pos += size;
+    }
+    if (!declared) declare(fstp, header, signals);
+    fstWriterClose(fstp);
+    return 0;
+}
@@ -0,0 +1,452 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// Code available from: https://verilator.org
+//
+// Copyright 2001-2023 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//=============================================================================
+///
+/// \file
+/// \brief Verilated C++ tracing in compact binary format implementation code
+///
+/// This file must be compiled and linked against all Verilated objects
+/// that use --trace-bin.
+///
+/// Use "verilator --trace-bin" to add this to the Makefile for the linker.
+///
+//=============================================================================
+
+// clang-format off
+
+#include "verilatedos.h"
+#include "verilated.h"
+#include "verilated_bin_c.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+
+#if defined(_WIN32) && !defined(__MINGW32__) && !defined(__CYGWIN__)
+# include <io.h>
+#else
+# include <unistd.h>
+#endif
+
+#ifndef O_LARGEFILE  // WIN32 headers omit this
+# define O_LARGEFILE 0
+#endif
+#ifndef O_CLOEXEC  // WIN32 headers omit this
+# define O_CLOEXEC 0
+#endif
+#ifndef O_BINARY  // Only WIN32 headers have this
+# define O_BINARY 0
+#endif
+
+// clang-format on
+
+constexpr size_t VL_TRACE_BIN_BLOCK_HEADER_SIZE = 8;  // Block type, 3 reserved, 32 bit size
+constexpr size_t VL_TRACE_BIN_TIME_RECORD_SIZE = 9;  // Code 0, 64 bit time
+constexpr size_t VL_TRACE_BIN_MAX_CODE_SIZE = 5;  // Maximum length of a 32 bit varint
+
+//=============================================================================
+// Specialization of the generics for this trace format
+
+#define VL_SUB_T VerilatedBin
+#define VL_BUF_T VerilatedBinBuffer
+#include "verilated_trace_imp.h"
+#undef VL_SUB_T
+#undef VL_BUF_T
+
+//=============================================================================
+// Little endian encoding
+
+static inline char* VerilatedBinWriteLE(char* writep, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        *writep++ = static_cast<char>(value & 0xff);
+        value >>= 8;
+    }
+    return writep;
+}
+
+static inline uint32_t VerilatedBinBytes(int bits) { return (bits + 7) / 8; }
+
+//=============================================================================
+//=============================================================================
+//=============================================================================
+// VerilatedBin
+
+VerilatedBin::VerilatedBin() {
+    // Not in header to avoid link issue if header is included without this .cpp file
+    bufferResize(1024);
+}
+
+VerilatedBin::~VerilatedBin() {
+    close();
+    if (m_wrBufp) VL_DO_CLEAR(delete[] m_wrBufp, m_wrBufp = nullptr);
+    if (parallel()) {
+        assert(m_numBuffers == m_freeBuffers.size());
+        for (auto& pair : m_freeBuffers) VL_DO_CLEAR(delete[] pair.first, pair.first = nullptr);
+    }
+}
+
+void VerilatedBin::open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    if (isOpen()) return;
+
+    m_filename = filename;
+    m_fd = ::open(m_filename.c_str(),
+                  O_CREAT | O_WRONLY | O_TRUNC | O_LARGEFILE | O_CLOEXEC | O_BINARY, 0666);
+    if (m_fd < 0) return;  // User code can check isOpen()
+    m_isOpen = true;
+
+    writeRaw("VLTBIN01", 8);
+
+    // Signal header, filled in by the decl* calls from traceInit
+    m_header = "timescale ";
+    m_header += timeResStr();
+    m_header += "\n";
+    Super::traceInit();
+    writeBlock('H', m_header.data(), m_header.size());
+    m_header.clear();
+    m_header.shrink_to_fit();
+
+    m_timeui = 0;
+    bufferStart();
+    fullDump(true);  // First dump must be full
+}
+
+void VerilatedBin::closeErr() {
+    // This function is on the flush() call path
+    // Close due to an error.  We might abort before even getting here,
+    // depending on the definition of vl_fatal.
+    if (!isOpen()) return;
+
+    // No buffer flush, just close
+    m_isOpen = false;
+    ::close(m_fd);  // May get error, just ignore it
+}
+
+void VerilatedBin::close() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    // This function is on the flush() call path
+    const VerilatedLockGuard lock{m_mutex};
+    if (!isOpen()) return;
+    Super::flushBase();
+    bufferFlush();
+    m_isOpen = false;
+    ::close(m_fd);
+    Super::closeBase();
+}
+
+void VerilatedBin::flush() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    Super::flushBase();
+    bufferFlush();
+}
+
+void VerilatedBin::flightFlush() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    if (!isOpen()) return;
+    Super::flightWrite();
+    Super::flushBase();
+    bufferFlush();
+}
+
+void VerilatedBin::bufferResize(size_t minsize) {
+    // The buffer holds a whole block, plus room for minsize bytes past the flush point
+    const size_t newSize = roundUpToMultipleOf<1024>(VL_TRACE_BIN_BLOCK_HEADER_SIZE
+                                                     + m_blockSize + 2 * minsize);
+    if (VL_LIKELY(newSize <= m_wrSize)) return;
+    char* oldbufp = m_wrBufp;
+    m_wrSize = newSize;
+    m_wrBufp = new char[m_wrSize];
+    if (oldbufp) {
+        std::memcpy(m_wrBufp, oldbufp, m_writep - oldbufp);
+        m_writep = m_wrBufp + (m_writep - oldbufp);
+        VL_DO_CLEAR(delete[] oldbufp, oldbufp = nullptr);
+    } else {
+        m_writep = m_wrBufp + VL_TRACE_BIN_BLOCK_HEADER_SIZE;
+    }
+    m_wrFlushp = m_wrBufp + VL_TRACE_BIN_BLOCK_HEADER_SIZE + m_blockSize;
+}
+
+void VerilatedBin::bufferStart() {
+    // Start a new data block, restating the current time so the block
+    // can be decoded on its own
+    m_writep = m_wrBufp + VL_TRACE_BIN_BLOCK_HEADER_SIZE;
+    *m_writep++ = 0;
+    m_writep = VerilatedBinWriteLE(m_writep, m_timeui, 8);
+}
+
+void VerilatedBin::bufferFlush() VL_MT_UNSAFE_ONE {
+    // This function is on the flush() call path
+    if (VL_UNLIKELY(!isOpen())) return;
+    const size_t size = m_writep - m_wrBufp - VL_TRACE_BIN_BLOCK_HEADER_SIZE;
+    // Nothing but the initial time change, nothing to write
+    if (size <= VL_TRACE_BIN_TIME_RECORD_SIZE) return;
+    m_wrBufp[0] = 'D';
+    m_wrBufp[1] = m_wrBufp[2] = m_wrBufp[3] = 0;
+    VerilatedBinWriteLE(m_wrBufp + 4, size, 4);
+    writeRaw(m_wrBufp, m_writep - m_wrBufp);
+    bufferStart();
+}
+
+void VerilatedBin::writeBlock(char type, const char* payloadp, size_t size) {
+    char header[VL_TRACE_BIN_BLOCK_HEADER_SIZE] = {type, 0, 0, 0};
+    VerilatedBinWriteLE(header + 4, size, 4);
+    writeRaw(header, sizeof(header));
+    writeRaw(payloadp, size);
+}
+
+void VerilatedBin::writeRaw(const char* bufp, size_t len) {
+    const char* wp = bufp;
+    const char* const endp = bufp + len;
+    while (isOpen() && wp < endp) {
+        errno = 0;
+        const ssize_t got = ::write(m_fd, wp, endp - wp);
+        if (got > 0) {
+            wp += got;
+        } else if (VL_UNCOVERABLE(got < 0)) {
+            if (VL_UNCOVERABLE(errno != EAGAIN && errno != EINTR)) {
+                // LCOV_EXCL_START
+                // write failed, presume error (perhaps out of disk space)
+                const std::string msg
+                    = std::string{"VerilatedBin::writeRaw: "} + std::strerror(errno);
+                VL_FATAL_MT("", 0, "", msg.c_str());
+                closeErr();
+                break;
+                // LCOV_EXCL_STOP
+            }
+        }
+    }
+}
+
+void VerilatedBin::emitTimeChange(uint64_t timeui) {
+    // If the block holds only its initial time change, replace it
+    if (m_writep == m_wrBufp + VL_TRACE_BIN_BLOCK_HEADER_SIZE + VL_TRACE_BIN_TIME_RECORD_SIZE) {
+        m_writep = m_wrBufp + VL_TRACE_BIN_BLOCK_HEADER_SIZE;
+    }
+    m_timeui = timeui;
+    *m_writep++ = 0;
+    m_writep = VerilatedBinWriteLE(m_writep, timeui, 8);
+    bufferCheck();
+}
+
+//=============================================================================
+// Definitions
+
+void VerilatedBin::declare(uint32_t code, const char* name, char type, bool array, int arraynum,
+                           int msb, int lsb) {
+    const int bits = ((msb > lsb) ? (msb - lsb) : (lsb - msb)) + 1;
+
+    const bool enabled = Super::declCode(code, name, bits, false);
+
+    // Keep upper bound on bytes a single signal can emit into the buffer
+    m_maxSignalBytes
+        = std::max<size_t>(m_maxSignalBytes, VL_TRACE_BIN_MAX_CODE_SIZE + VerilatedBinBytes(bits)
+                                                 + VL_TRACE_BIN_TIME_RECORD_SIZE + 8);
+    // Make sure write buffer is large enough
+    bufferResize(m_maxSignalBytes);
+
+    if (!enabled) return;
+
+    // Split name into scopes and basename, as the VCD writer does:
+    // Space separates each level of scope
+    // Tab separates final scope from signal name
+    const std::string nameasstr = namePrefix() + name;
+    std::string hiername;
+    std::string basename;
+    for (const char* cp = nameasstr.c_str(); *cp; cp++) {
+        if (isScopeEscape(*cp)) {
+            if (!hiername.empty()) hiername += " ";
+            hiername += basename;
+            basename = "";
+        } else {
+            basename += *cp;
+        }
+    }
+    hiername += "\t" + basename;
+
+    constexpr size_t bufsize = 100;
+    char buf[bufsize];
+    VL_SNPRINTF(buf, bufsize, "var %" PRIu32 " %c %d %d %d %d\t", code, type, bits, msb, lsb,
+                array ? arraynum : -1);
+    m_header += buf;
+    m_header += hiername;
+    m_header += "\n";
+}
+
+void VerilatedBin::declEvent(uint32_t code, const char* name, bool array, int arraynum) {
+    declare(code, name, 'e', array, arraynum, 0, 0);
+}
+void VerilatedBin::declBit(uint32_t code, const char* name, bool array, int arraynum) {
+    declare(code, name, 'w', array, arraynum, 0, 0);
+}
+void VerilatedBin::declBus(uint32_t code, const char* name, bool array, int arraynum, int msb,
+                           int lsb) {
+    declare(code, name, 'v', array, arraynum, msb, lsb);
+}
+void VerilatedBin::declQuad(uint32_t code, const char* name, bool array, int arraynum, int msb,
+                            int lsb) {
+    declare(code, name, 'v', array, arraynum, msb, lsb);
+}
+void VerilatedBin::declArray(uint32_t code, const char* name, bool array, int arraynum, int msb,
+                             int lsb) {
+    declare(code, name, 'v', array, arraynum, msb, lsb);
+}
+void VerilatedBin::declDouble(uint32_t code, const char* name, bool array, int arraynum) {
+    declare(code, name, 'r', array, arraynum, 63, 0);
+}
+
+//=============================================================================
+// Get/commit trace buffer
+
+VerilatedBin::Buffer* VerilatedBin::getTraceBuffer() {
+    VerilatedBin::Buffer* const bufp = new Buffer{*this};
+    if (parallel()) {
+        // Note: This is called from VerilatedBin::dump, which already holds the lock
+        // If no buffer available, allocate a new one
+        if (m_freeBuffers.empty()) {
+            constexpr size_t pageSize = 4096;
+            // 4 * m_maxSignalBytes, so we can reserve 2 * m_maxSignalBytes at the end for safety
+            const size_t startingSize = roundUpToMultipleOf<pageSize>(4 * m_maxSignalBytes);
+            m_freeBuffers.emplace_back(new char[startingSize], startingSize);
+            ++m_numBuffers;
+        }
+        // Grab a buffer
+        const auto pair = m_freeBuffers.back();
+        m_freeBuffers.pop_back();
+        // Initialize
+        bufp->m_writep = bufp->m_bufp = pair.first;
+        bufp->m_size = pair.second;
+        bufp->adjustGrowp();
+    }
+    // Return the buffer
+    return bufp;
+}
+
+void VerilatedBin::commitTraceBuffer(VerilatedBin::Buffer* bufp) {
+    if (parallel()) {
+        // Note: This is called from VerilatedBin::dump, which already holds the lock
+        // Resize output buffer, using the full size of the trace buffer, as
+        // in VerilatedVcd::commitTraceBuffer
+        bufferResize(bufp->m_size);
+        // Copy to output buffer
+        const size_t usedSize = bufp->m_writep - bufp->m_bufp;
+        std::memcpy(m_writep, bufp->m_bufp, usedSize);
+        m_writep += usedSize;
+        // Flush if necessary
+        bufferCheck();
+        // Put buffer back on free list
+        m_freeBuffers.emplace_back(bufp->m_bufp, bufp->m_size);
+    } else {
+        // Needs adjusting for emitTimeChange
+        m_writep = bufp->m_writep;
+    }
+    delete bufp;
+}
+
+//=============================================================================
+// VerilatedBinBuffer implementation
+
+char* VerilatedBinBuffer::writeCode(char* writep, uint32_t code) {
+    // LEB128 varint, most codes fit in one or two bytes
+    while (code >= 0x80) {
+        *writep++ = static_cast<char>((code & 0x7f) | 0x80);
+        code >>= 7;
+    }
+    *writep++ = static_cast<char>(code);
+    return writep;
+}
+
+void VerilatedBinBuffer::finishRecord(char* writep) {
+    m_writep = writep;
+
+    if (m_owner.parallel()) {
+        // Double the size of the buffer if necessary
+        if (VL_UNLIKELY(m_writep >= m_growp)) {
+            const size_t usedSize = m_writep - m_bufp;
+            m_size *= 2;
+            char* const newBufp = new char[m_size];
+            std::memcpy(newBufp, m_bufp, usedSize);
+            delete[] m_bufp;
+            m_bufp = newBufp;
+            m_writep = m_bufp + usedSize;
+            adjustGrowp();
+        }
+    } else {
+        // Write out the block once it is full
+        if (VL_UNLIKELY(m_writep > m_wrFlushp)) {
+            m_owner.m_writep = m_writep;
+            m_owner.bufferFlush();
+            m_writep = m_owner.m_writep;
+        }
+    }
+}
+
+//=============================================================================
+// emit* trace routines
+
+// Note: emit* are only ever called from one place (full* in
+// verilated_trace_imp.h, which is included in this file at the top),
+// so always inline them.
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitEvent(uint32_t code, VlEvent newval) {
+    // Events have no value, only record the triggers
+    if (newval.isTriggered()) finishRecord(writeCode(m_writep, code));
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitBit(uint32_t code, CData newval) {
+    char* wp = writeCode(m_writep, code);
+    *wp++ = static_cast<char>(newval);
+    finishRecord(wp);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitCData(uint32_t code, CData newval, int /*bits*/) {
+    char* wp = writeCode(m_writep, code);
+    *wp++ = static_cast<char>(newval);
+    finishRecord(wp);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitSData(uint32_t code, SData newval, int bits) {
+    char* const wp = writeCode(m_writep, code);
+    finishRecord(VerilatedBinWriteLE(wp, newval, VerilatedBinBytes(bits)));
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitIData(uint32_t code, IData newval, int bits) {
+    char* const wp = writeCode(m_writep, code);
+    finishRecord(VerilatedBinWriteLE(wp, newval, VerilatedBinBytes(bits)));
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitQData(uint32_t code, QData newval, int bits) {
+    char* const wp = writeCode(m_writep, code);
+    finishRecord(VerilatedBinWriteLE(wp, newval, VerilatedBinBytes(bits)));
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitWData(uint32_t code, const WData* newvalp, int bits) {
+    char* wp = writeCode(m_writep, code);
+    const int words = VL_WORDS_I(bits);
+    // All but the most significant word are whole
+    for (int i = 0; i < words - 1; ++i) wp = VerilatedBinWriteLE(wp, newvalp[i], 4);
+    wp = VerilatedBinWriteLE(wp, newvalp[words - 1], VerilatedBinBytes(bits) - 4 * (words - 1));
+    finishRecord(wp);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitDouble(uint32_t code, double newval) {
+    char* const wp = writeCode(m_writep, code);
+    uint64_t bits;
+    std::memcpy(&bits, &newval, sizeof(bits));
+    finishRecord(VerilatedBinWriteLE(wp, bits, 8));
+}
@@ -0,0 +1,296 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// Code available from: https://verilator.org
+//
+// Copyright 2001-2023 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//=============================================================================
+///
+/// \file
+/// \brief Verilated tracing in compact binary format header
+///
+/// User wrapper code should use this header when creating binary traces.
+/// The binary trace is converted to VCD or FST after simulation using
+/// verilator_trace_convert.
+///
+//=============================================================================
+
+#ifndef VERILATOR_VERILATED_BIN_C_H_
+#define VERILATOR_VERILATED_BIN_C_H_
+
+#include "verilated.h"
+#include "verilated_trace.h"
+
+#include <string>
+#include <vector>
+
+class VerilatedBinBuffer;
+
+//=============================================================================
+// VerilatedBin
+// Base class to create a Verilator binary trace dump
+// This is an internally used class - see VerilatedBinC for what to call from applications
+//
+// File format (all integers little endian):
+//   "VLTBIN01" magic, followed by any number of blocks.
+//   Each block is a 8 byte block header {uint8_t type, 3 reserved bytes,
+//   uint32_t payload size}, followed by the payload.
+//   A 'H' (header) block holds the timescale and the signal declarations
+//   as text lines.
+//   A 'D' (data) block holds value change records. A record is a varint
+//   (LEB128) signal code, followed by the value in a fixed number of bytes
+//   determined by the signal's declaration. Code 0 is a time change,
+//   followed by the 8 byte time. Every data block starts with a time
+//   change, so blocks can be decoded independently of each other.
+
+class VerilatedBin VL_NOT_FINAL : public VerilatedTrace<VerilatedBin, VerilatedBinBuffer> {
+public:
+    using Super = VerilatedTrace<VerilatedBin, VerilatedBinBuffer>;
+
+private:
+    friend VerilatedBinBuffer;  // Give the buffer access to the private bits
+
+    //=========================================================================
+    // Binary format specific internals
+
+    int m_fd = -1;  // File descriptor we're writing to
+    bool m_isOpen = false;  // True indicates open file
+    std::string m_filename;  // Filename we're writing to (if open)
+    size_t m_blockSize = 64 * 1024;  // Data block payload size to flush at
+
+    char* m_wrBufp = nullptr;  // Output buffer holding the current data block
+    char* m_wrFlushp = nullptr;  // Output buffer flush trigger location
+    char* m_writep = nullptr;  // Write pointer into output buffer
+    size_t m_wrSize = 0;  // Output buffer size
+    size_t m_maxSignalBytes = 0;  // Upper bound on number of bytes a single signal can generate
+    uint64_t m_timeui = 0;  // Time of the last time change, restated in each new block
+
+    std::string m_header;  // Header block text built during declaration
+
+    // Vector of free trace buffers as (pointer, size) pairs.
+    std::vector<std::pair<char*, size_t>> m_freeBuffers;
+    size_t m_numBuffers = 0;  // Number of trace buffers allocated
+
+    void bufferResize(size_t minsize);
+    void bufferStart();
+    void bufferFlush() VL_MT_UNSAFE_ONE;
+    void bufferCheck() {
+        // Flush the current block once it reaches the block size
+        if (VL_UNLIKELY(m_writep > m_wrFlushp)) bufferFlush();
+    }
+    void writeBlock(char type, const char* payloadp, size_t size);
+    void writeRaw(const char* bufp, size_t len);
+    void closeErr();
+    void declare(uint32_t code, const char* name, char type, bool array, int arraynum, int msb,
+                 int lsb);
+
+    // CONSTRUCTORS
+    VL_UNCOPYABLE(VerilatedBin);
+
+protected:
+    //=========================================================================
+    // Implementation of VerilatedTrace interface
+
+    // Called when the trace moves forward to a new time point
+    void emitTimeChange(uint64_t timeui) override;
+
+    // Hooks called from VerilatedTrace
+    bool preFullDump() override { return isOpen(); }
+    bool preChangeDump() override { return isOpen(); }
+
+    // Trace buffer management
+    Buffer* getTraceBuffer() override;
+    void commitTraceBuffer(Buffer*) override;
+
+    // Configure sub-class
+    void configure(const VerilatedTraceConfig&) override{};
+
+public:
+    //=========================================================================
+    // External interface to client code
+
+    // CONSTRUCTOR
+    VerilatedBin();
+    ~VerilatedBin();
+
+    // ACCESSORS
+    // Set data block payload size in bytes
+    void blockSize(size_t size) VL_MT_SAFE { m_blockSize = size; }
+
+    // METHODS - All must be thread safe
+    // Open the file; call isOpen() to see if errors
+    void open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Close the file
+    void close() VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Flush any remaining data to this file
+    void flush() VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Write the flight recorded changes to this file, then flush it
+    void flightFlush() VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Return if file is open
+    bool isOpen() const VL_MT_SAFE { return m_isOpen; }
+
+    //=========================================================================
+    // Internal interface to Verilator generated code
+
+    void declEvent(uint32_t code, const char* name, bool array, int arraynum);
+    void declBit(uint32_t code, const char* name, bool array, int arraynum);
+    void declBus(uint32_t code, const char* name, bool array, int arraynum, int msb, int lsb);
+    void declQuad(uint32_t code, const char* name, bool array, int arraynum, int msb, int lsb);
+    void declArray(uint32_t code, const char* name, bool array, int arraynum, int msb, int lsb);
+    void declDouble(uint32_t code, const char* name, bool array, int arraynum);
+};
+
+#ifndef DOXYGEN
+// Declare specialization here as it's used in VerilatedBinC just below
+template <>
+void VerilatedBin::Super::dump(uint64_t time);
+template <>
+void VerilatedBin::Super::set_time_unit(const char* unitp);
+template <>
+void VerilatedBin::Super::set_time_unit(const std::string& unit);
+template <>
+void VerilatedBin::Super::set_time_resolution(const char* unitp);
+template <>
+void VerilatedBin::Super::set_time_resolution(const std::string& unit);
+template <>
+void VerilatedBin::Super::dumpvars(int level, const std::string& hier);
+template <>
+void VerilatedBin::Super::flightRecorder(size_t maxDumps, size_t maxBytes);
+#endif  // DOXYGEN
+
+//=============================================================================
+// VerilatedBinBuffer
+
+class VerilatedBinBuffer VL_NOT_FINAL {
+    // Give the trace file and sub-classes access to the private bits
+    friend VerilatedBin;
+    friend VerilatedBin::Super;
+    friend VerilatedBin::Buffer;
+    friend VerilatedBin::OffloadBuffer;
+
+    VerilatedBin& m_owner;  // Trace file owning this buffer. Required by subclasses.
+
+    // Write pointer into output buffer (in parallel mode, this is set up in 'getTraceBuffer')
+    char* m_writep = m_owner.parallel() ? nullptr : m_owner.m_writep;
+    // Output buffer flush trigger location (only used when not parallel)
+    char* const m_wrFlushp = m_owner.parallel() ? nullptr : m_owner.m_wrFlushp;
+
+    // The maximum number of bytes a single signal can emit
+    const size_t m_maxSignalBytes = m_owner.m_maxSignalBytes;
+
+    // Additional data for parallel tracing only
+    char* m_bufp = nullptr;  // The beginning of the trace buffer
+    size_t m_size = 0;  // The size of the buffer at m_bufp
+    char* m_growp = nullptr;  // Resize limit pointer
+
+    void adjustGrowp() {
+        m_growp = (m_bufp + m_size) - (2 * m_maxSignalBytes);
+        assert(m_growp >= m_bufp + m_maxSignalBytes);
+    }
+
+    static char* writeCode(char* writep, uint32_t code);
+    void finishRecord(char* writep);
+
+    // CONSTRUCTOR
+    explicit VerilatedBinBuffer(VerilatedBin& owner)
+        : m_owner{owner} {}
+    virtual ~VerilatedBinBuffer() = default;
+
+    //=========================================================================
+    // Implementation of VerilatedTraceBuffer interface
+    // Implementations of duck-typed methods for VerilatedTraceBuffer. These are
+    // called from only one place (the full* methods), so always inline them.
+    VL_ATTR_ALWINLINE void emitEvent(uint32_t code, VlEvent newval);
+    VL_ATTR_ALWINLINE void emitBit(uint32_t code, CData newval);
+    VL_ATTR_ALWINLINE void emitCData(uint32_t code, CData newval, int bits);
+    VL_ATTR_ALWINLINE void emitSData(uint32_t code, SData newval, int bits);
+    VL_ATTR_ALWINLINE void emitIData(uint32_t code, IData newval, int bits);
+    VL_ATTR_ALWINLINE void emitQData(uint32_t code, QData newval, int bits);
+    VL_ATTR_ALWINLINE void emitWData(uint32_t code, const WData* newvalp, int bits);
+    VL_ATTR_ALWINLINE void emitDouble(uint32_t code, double newval);
+};
+
+//=============================================================================
+// VerilatedBinC
+/// Class representing a binary trace dump file in C standalone (no SystemC)
+/// simulations.  Also derived for use in SystemC simulations.
+/// Convert the resulting file with verilator_trace_convert.
+
+class VerilatedBinC VL_NOT_FINAL {
+    VerilatedBin m_sptrace;  // Trace file being created
+
+    // CONSTRUCTORS
+    VL_UNCOPYABLE(VerilatedBinC);
+
+public:
+    /// Construct the dump
+    VerilatedBinC() = default;
+    /// Destruct, flush, and close the dump
+    virtual ~VerilatedBinC() { close(); }
+
+    // METHODS - User called
+
+    /// Return if file is open
+    bool isOpen() const VL_MT_SAFE { return m_sptrace.isOpen(); }
+    /// Open a new binary trace file
+    /// This includes a complete header dump each time it is called,
+    /// just as if this object was deleted and reconstructed.
+    virtual void open(const char* filename) VL_MT_SAFE { m_sptrace.open(filename); }
+    /// Set the size in bytes of each data block written to the file
+    /// (default 64KiB). Must be called before open().
+    void blockSize(size_t size) VL_MT_SAFE { m_sptrace.blockSize(size); }
+    /// Record value changes in memory instead of writing them to the file,
+    /// keeping only the last maxDumps calls to dump(), using up to about
+    /// maxBytes of memory (0 = no limit). The recorded changes are only
+    /// written by flightFlush(), which is also called on $stop, $fatal,
+    /// failing assertions and $dumpflush. Must be called before open().
+    void flightRecorder(size_t maxDumps, size_t maxBytes = 0) VL_MT_SAFE {
+        m_sptrace.flightRecorder(maxDumps, maxBytes);
+    }
+    /// Write the changes recorded by flightRecorder() to the file, then flush it
+    void flightFlush() VL_MT_SAFE { m_sptrace.flightFlush(); }
+    /// Close dump
+    void close() VL_MT_SAFE { m_sptrace.close(); }
+    /// Flush dump
+    void flush() VL_MT_SAFE { m_sptrace.flush(); }
+    /// Write one cycle of dump data
+    /// Call with the current context's time just after eval'ed,
+    /// e.g. ->dump(contextp->time())
+    void dump(uint64_t timeui) VL_MT_SAFE { m_sptrace.dump(timeui); }
+    /// Write one cycle of dump data - backward compatible and to reduce
+    /// conversion warnings.  It's better to use a uint64_t time instead.
+    void dump(double timestamp) { dump(static_cast<uint64_t>(timestamp)); }
+    void dump(uint32_t timestamp) { dump(static_cast<uint64_t>(timestamp)); }
+    void dump(int timestamp) { dump(static_cast<uint64_t>(timestamp)); }
+
+    // METHODS - Internal/backward compatible
+    // \protectedsection
+
+    // Set time units (s/ms, defaults to ns)
+    // Users should not need to call this, as for Verilated models, these
+    // propage from the Verilated default timeunit
+    void set_time_unit(const char* unit) VL_MT_SAFE { m_sptrace.set_time_unit(unit); }
+    void set_time_unit(const std::string& unit) VL_MT_SAFE { m_sptrace.set_time_unit(unit); }
+    // Set time resolution (s/ms, defaults to ns)
+    // Users should not need to call this, as for Verilated models, these
+    // propage from the Verilated default timeprecision
+    void set_time_resolution(const char* unit) VL_MT_SAFE { m_sptrace.set_time_resolution(unit); }
+    void set_time_resolution(const std::string& unit) VL_MT_SAFE {
+        m_sptrace.set_time_resolution(unit);
+    }
+    // Set variables to dump, using $dumpvars format
+    // If level = 0, dump everything and hier is then ignored
+    void dumpvars(int level, const std::string& hier) VL_MT_SAFE {
+        m_sptrace.dumpvars(level, hier);
+    }
+
+    // Internal class access
+    VerilatedBin* spTrace() { return &m_sptrace; }
+};
+
+#endif  // guard
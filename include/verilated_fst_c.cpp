@@ -101,7 +101,8 @@ VerilatedFst::~VerilatedFst() {
 void VerilatedFst::open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex) {
     const VerilatedLockGuard lock{m_mutex};
     m_fst = fstWriterCreate(filename, 1);
-    fstWriterSetPackType(m_fst, FST_WR_PT_LZ4);
+    fstWriterSetPackType(m_fst, m_packType);
+    fstWriterSetPackThreads(m_fst, m_packThreads);
     fstWriterSetTimescaleFromString(m_fst, timeResStr().c_str());  // lintok-begin-on-ref
     if (m_useFstWriterThread) fstWriterSetParallelMode(m_fst, 1);
     fullDump(true);  // First dump must be full for fst
@@ -141,6 +142,14 @@ void VerilatedFst::flush() VL_MT_SAFE_EXCLUDES(m_mutex) {
     fstWriterFlushContext(m_fst);
 }
 
+void VerilatedFst::flightFlush() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    if (!m_fst) return;
+    Super::flightWrite();
+    Super::flushBase();
+    fstWriterFlushContext(m_fst);
+}
+
 void VerilatedFst::emitTimeChange(uint64_t timeui) { fstWriterEmitTimeChange(m_fst, timeui); }
 
 //=============================================================================
@@ -251,7 +260,13 @@ void VerilatedFst::declDouble(uint32_t code, const char* name, int dtypenum, fst
 
 VerilatedFst::Buffer* VerilatedFst::getTraceBuffer() {
     if (offload()) return new OffloadBuffer{*this};
-    return new Buffer{*this};
+    Buffer* const bufp = new Buffer{*this};
+    if (parallel() && !m_freeChanges.empty()) {
+        // Note: This is called from VerilatedFst::dump, which already holds the lock
+        bufp->m_changes = std::move(m_freeChanges.back());
+        m_freeChanges.pop_back();
+    }
+    return bufp;
 }
 
 void VerilatedFst::commitTraceBuffer(VerilatedFst::Buffer* bufp) {
@@ -262,6 +277,24 @@ void VerilatedFst::commitTraceBuffer(VerilatedFst::Buffer* bufp) {
             return;  // Buffer will be deleted by the offload thread
         }
     }
+    if (parallel()) {
+        // Note: This is called from VerilatedFst::dump, which already holds the lock
+        // Emit the changes recorded by the buffer, buffers are committed in code order
+        const char* readp = bufp->m_changes.data();
+        const char* const endp = readp + bufp->m_changes.size();
+        while (readp < endp) {
+            uint32_t code;
+            uint32_t size;
+            std::memcpy(&code, readp, sizeof(code));
+            std::memcpy(&size, readp + sizeof(code), sizeof(size));
+            readp += sizeof(code) + sizeof(size);
+            fstWriterEmitValueChange(m_fst, m_symbolp[code], readp);
+            readp += size;
+        }
+        // Keep the storage for reuse
+        bufp->m_changes.clear();
+        m_freeChanges.push_back(std::move(bufp->m_changes));
+    }
     delete bufp;
 }
 
@@ -283,54 +316,70 @@ void VerilatedFst::configure(const VerilatedTraceConfig& config) {
 // verilated_trace_imp.h, which is included in this file at the top),
 // so always inline them.
 
+char* VerilatedFstBuffer::recordp(uint32_t code, uint32_t size) {
+    const size_t pos = m_changes.size();
+    m_changes.resize(pos + sizeof(code) + sizeof(size) + size);
+    char* const writep = m_changes.data() + pos;
+    std::memcpy(writep, &code, sizeof(code));
+    std::memcpy(writep + sizeof(code), &size, sizeof(size));
+    return writep + sizeof(code) + sizeof(size);
+}
+
 VL_ATTR_ALWINLINE
-void VerilatedFstBuffer::emitEvent(uint32_t code, VlEvent newval) {
+void VerilatedFstBuffer::emitValueChange(uint32_t code, const char* valuep, uint32_t size) {
     VL_DEBUG_IFDEF(assert(m_symbolp[code]););
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], "1");
+    if (VL_UNLIKELY(m_owner.parallel())) {
+        std::memcpy(recordp(code, size), valuep, size);
+    } else {
+        fstWriterEmitValueChange(m_fst, m_symbolp[code], valuep);
+    }
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedFstBuffer::emitEvent(uint32_t code, VlEvent newval) {
+    emitValueChange(code, "1", 1);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitBit(uint32_t code, CData newval) {
-    VL_DEBUG_IFDEF(assert(m_symbolp[code]););
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], newval ? "1" : "0");
+    emitValueChange(code, newval ? "1" : "0", 1);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitCData(uint32_t code, CData newval, int bits) {
     char buf[VL_BYTESIZE];
-    VL_DEBUG_IFDEF(assert(m_symbolp[code]););
     cvtCDataToStr(buf, newval << (VL_BYTESIZE - bits));
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], buf);
+    emitValueChange(code, buf, bits);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitSData(uint32_t code, SData newval, int bits) {
     char buf[VL_SHORTSIZE];
-    VL_DEBUG_IFDEF(assert(m_symbolp[code]););
     cvtSDataToStr(buf, newval << (VL_SHORTSIZE - bits));
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], buf);
+    emitValueChange(code, buf, bits);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitIData(uint32_t code, IData newval, int bits) {
     char buf[VL_IDATASIZE];
-    VL_DEBUG_IFDEF(assert(m_symbolp[code]););
     cvtIDataToStr(buf, newval << (VL_IDATASIZE - bits));
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], buf);
+    emitValueChange(code, buf, bits);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitQData(uint32_t code, QData newval, int bits) {
     char buf[VL_QUADSIZE];
-    VL_DEBUG_IFDEF(assert(m_symbolp[code]););
     cvtQDataToStr(buf, newval << (VL_QUADSIZE - bits));
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], buf);
+    emitValueChange(code, buf, bits);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitWData(uint32_t code, const WData* newvalp, int bits) {
+    // The string buffer is shared, so when tracing in parallel, convert into the record
+    const bool parallel = m_owner.parallel();
+    char* const bufp = VL_UNLIKELY(parallel) ? recordp(code, bits) : m_strbufp;
     int words = VL_WORDS_I(bits);
-    char* wp = m_strbufp;
+    char* wp = bufp;
     // Convert the most significant word
     const int bitsInMSW = VL_BITBIT_E(bits) ? VL_BITBIT_E(bits) : VL_EDATASIZE;
     cvtEDataToStr(wp, newvalp[--words] << (VL_EDATASIZE - bitsInMSW));
@@ -340,10 +389,10 @@ void VerilatedFstBuffer::emitWData(uint32_t code, const WData* newvalp, int bits
         cvtEDataToStr(wp, newvalp[--words]);
         wp += VL_EDATASIZE;
     }
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], m_strbufp);
+    if (VL_LIKELY(!parallel)) fstWriterEmitValueChange(m_fst, m_symbolp[code], bufp);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitDouble(uint32_t code, double newval) {
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], &newval);
+    emitValueChange(code, reinterpret_cast<const char*>(&newval), sizeof(newval));
 }
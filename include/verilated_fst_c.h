@@ -56,6 +56,11 @@ private:
     char* m_strbufp = nullptr;  // String buffer long enough to hold maxBits() chars
 
     bool m_useFstWriterThread = false;  // Whether to use the separate FST writer thread
+    fstWriterPackType m_packType = FST_WR_PT_LZ4;  // Packer compressing value change blocks
+    int m_packThreads = 1;  // Threads compressing each value change block
+
+    // Change record storage of committed buffers, for reuse when tracing in parallel
+    std::vector<std::vector<char>> m_freeChanges;
 
     // CONSTRUCTORS
     VL_UNCOPYABLE(VerilatedFst);
@@ -88,6 +93,12 @@ public:
     explicit VerilatedFst(void* fst = nullptr);
     ~VerilatedFst();
 
+    // ACCESSORS
+    // Set packer compressing the value change blocks, before open()
+    void packType(fstWriterPackType type) VL_MT_SAFE { m_packType = type; }
+    // Set number of threads compressing each value change block, before open()
+    void packThreads(int threads) VL_MT_SAFE { m_packThreads = threads; }
+
     // METHODS - All must be thread safe
     // Open the file; call isOpen() to see if errors
     void open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex);
@@ -95,6 +106,8 @@ public:
     void close() VL_MT_SAFE_EXCLUDES(m_mutex);
     // Flush any remaining data to this file
     void flush() VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Write the flight recorded changes to this file, then flush it
+    void flightFlush() VL_MT_SAFE_EXCLUDES(m_mutex);
     // Return if file is open
     bool isOpen() const VL_MT_SAFE { return m_fst != nullptr; }
 
@@ -132,6 +145,8 @@ template <>
 void VerilatedFst::Super::set_time_resolution(const std::string& unit);
 template <>
 void VerilatedFst::Super::dumpvars(int level, const std::string& hier);
+template <>
+void VerilatedFst::Super::flightRecorder(size_t maxDumps, size_t maxBytes);
 #endif
 
 //=============================================================================
@@ -153,6 +168,10 @@ class VerilatedFstBuffer VL_NOT_FINAL {
     // String buffer long enough to hold maxBits() chars
     char* const m_strbufp = m_owner.m_strbufp;
 
+    // Value changes recorded when tracing in parallel, emitted in order when the buffer is
+    // committed. Each record is the code, the size of the value in bytes, then the value.
+    std::vector<char> m_changes;
+
     // CONSTRUCTOR
     explicit VerilatedFstBuffer(VerilatedFst& owner)
         : m_owner{owner} {}
@@ -171,6 +190,11 @@ class VerilatedFstBuffer VL_NOT_FINAL {
     VL_ATTR_ALWINLINE void emitQData(uint32_t code, QData newval, int bits);
     VL_ATTR_ALWINLINE void emitWData(uint32_t code, const WData* newvalp, int bits);
     VL_ATTR_ALWINLINE void emitDouble(uint32_t code, double newval);
+
+    // Emit, or record when tracing in parallel, a value change
+    VL_ATTR_ALWINLINE void emitValueChange(uint32_t code, const char* valuep, uint32_t size);
+    // Append a change record, and return where its value of 'size' bytes is to be written
+    char* recordp(uint32_t code, uint32_t size);
 };
 
 //=============================================================================
@@ -201,6 +225,24 @@ public:
     void close() VL_MT_SAFE { m_sptrace.close(); }
     /// Flush dump
     void flush() VL_MT_SAFE { m_sptrace.flush(); }
+    /// Record value changes in memory instead of writing them to the file,
+    /// keeping only the last maxDumps calls to dump(), using up to about
+    /// maxBytes of memory (0 = no limit). The recorded changes are only
+    /// written by flightFlush(), which is also called on $stop, $fatal,
+    /// failing assertions and $dumpflush. Must be called before open().
+    void flightRecorder(size_t maxDumps, size_t maxBytes = 0) VL_MT_SAFE {
+        m_sptrace.flightRecorder(maxDumps, maxBytes);
+    }
+    /// Write the changes recorded by flightRecorder() to the file, then flush it
+    void flightFlush() VL_MT_SAFE { m_sptrace.flightFlush(); }
+    /// Set the packer compressing the value changes; FST_WR_PT_LZ4 (the
+    /// default, fastest), FST_WR_PT_FASTLZ or FST_WR_PT_ZLIB (smallest).
+    /// Must be called before open().
+    void packType(fstWriterPackType type) VL_MT_SAFE { m_sptrace.packType(type); }
+    /// Set the number of threads compressing each block of value changes
+    /// (default 1). The file is the same for any number of threads.
+    /// Must be called before open().
+    void packThreads(int threads) VL_MT_SAFE { m_sptrace.packThreads(threads); }
     /// Write one cycle of dump data
     /// Call with the current context's time just after eval'ed,
     /// e.g. ->dump(contextp->time())
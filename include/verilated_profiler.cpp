@@ -22,6 +22,7 @@
 
 #include "verilated_threads.h"
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 
@@ -31,6 +32,8 @@
 // Internal note: Globals may multi-construct, see verilated.cpp top.
 
 thread_local VlExecutionProfiler::ExecutionTrace VlExecutionProfiler::t_trace;
+thread_local VlExecutionProfiler::GateCounts VlExecutionProfiler::t_gateCounts;
+thread_local std::vector<VlExecutionProfiler::SettleCounts> VlExecutionProfiler::t_settleCounts;
 
 constexpr const char* const VlExecutionRecord::s_ascii[];
 
@@ -79,14 +82,22 @@ void VlExecutionProfiler::configure() {
         if (VL_UNLIKELY(m_windowCount == m_context.profExecWindow())) {
             VL_DEBUG_IF(VL_DBG_MSGF("+ profile start collection\n"););
             clear();  // Clear the profile after the cache warm-up cycles.
+            VlMTaskVertex::waitHistogramStart();
             m_tickBegin = VL_CPU_TICK();
+            m_wallBegin = std::chrono::steady_clock::now();
+            m_evalCount = 0;
         } else if (VL_UNLIKELY(m_windowCount == 0)) {
             const uint64_t tickEnd = VL_CPU_TICK();
+            const auto wallEnd = std::chrono::steady_clock::now();
             VL_DEBUG_IF(VL_DBG_MSGF("+ profile end\n"););
+            VlMTaskVertex::waitHistogramStop();
             const std::string& fileName = m_context.profExecFilename();
-            dump(fileName.c_str(), tickEnd);
+            dump(fileName.c_str(), tickEnd, wallEnd);
             m_enabled = false;
+            return;
         }
+        // Count the evaluations within the profile window, past the warm-up
+        if (m_windowCount <= m_context.profExecWindow()) ++m_evalCount;
         return;
     }
 
@@ -135,6 +146,8 @@ void VlExecutionProfiler::setupThread(uint32_t threadId) {
     {
         const VerilatedLockGuard lock{m_mutex};
         exists = !m_traceps.emplace(threadId, &t_trace).second;
+        m_gateCountps.emplace(threadId, &t_gateCounts);
+        m_settleCountps.emplace(threadId, &t_settleCounts);
     }
     if (VL_UNLIKELY(exists)) {
         VL_FATAL_MT(__FILE__, __LINE__, "", "multiple initialization of profiler on some thread");
@@ -149,9 +162,13 @@ void VlExecutionProfiler::clear() VL_MT_SAFE_EXCLUDES(m_mutex) {
         tracep->clear();
         tracep->reserve(reserve);
     }
+    for (const auto& pair : m_gateCountps) *pair.second = GateCounts{};
+    for (const auto& pair : m_settleCountps) pair.second->clear();
+    if (m_frameCountsCb) m_frameCountsBegin = m_frameCountsCb();
 }
 
-void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
+void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd,
+                               std::chrono::steady_clock::time_point wallEnd)
     VL_MT_SAFE_EXCLUDES(m_mutex) {
     const VerilatedLockGuard lock{m_mutex};
     VL_DEBUG_IF(VL_DBG_MSGF("+prof+exec writing to '%s'\n", filenamep););
@@ -169,6 +186,66 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
     const unsigned threads = static_cast<unsigned>(m_traceps.size());
     fprintf(fp, "VLPROF stat threads %u\n", threads);
     fprintf(fp, "VLPROF stat yields %" PRIu64 "\n", VlMTaskVertex::yields());
+    fprintf(fp, "VLPROF stat parks %" PRIu64 "\n", VlMTaskVertex::parks());
+    // Evaluation rate over the collection window, to compare e.g. thread affinity settings
+    const VlThreadPool* const threadPoolp = static_cast<VlThreadPool*>(m_context.threadPoolp());
+    const std::chrono::duration<double> wallElapsed = wallEnd - m_wallBegin;
+    fprintf(fp, "VLPROF stat pinned %d\n", threadPoolp && threadPoolp->pinned() ? 1 : 0);
+    fprintf(fp, "VLPROF stat evals %" PRIu64 "\n", m_evalCount);
+    fprintf(fp, "VLPROF stat seconds %.6f\n", wallElapsed.count());
+    // Activity gating counts summed over all threads, only present if anything was gated
+    {
+        GateCounts total;
+        for (const auto& pair : m_gateCountps) {
+            total.m_evals += pair.second->m_evals;
+            total.m_skips += pair.second->m_skips;
+        }
+        if (total.m_evals || total.m_skips) {
+            fprintf(fp, "VLPROF stat gate-evals %" PRIu64 "\n", total.m_evals);
+            fprintf(fp, "VLPROF stat gate-skips %" PRIu64 "\n", total.m_skips);
+        }
+    }
+    // Combinational loop settling counts summed over all threads, by loop id
+    {
+        std::vector<SettleCounts> total;
+        for (const auto& pair : m_settleCountps) {
+            const std::vector<SettleCounts>& counts = *pair.second;
+            if (counts.size() > total.size()) total.resize(counts.size());
+            for (size_t id = 0; id < counts.size(); ++id) {
+                if (!counts[id].m_evals) continue;
+                total[id].m_namep = counts[id].m_namep;
+                total[id].m_evals += counts[id].m_evals;
+                total[id].m_iterations += counts[id].m_iterations;
+                total[id].m_maxIterations
+                    = std::max(total[id].m_maxIterations, counts[id].m_maxIterations);
+            }
+        }
+        for (size_t id = 0; id < total.size(); ++id) {
+            if (!total[id].m_evals) continue;
+            fprintf(fp, "VLPROFSETTLE %zu %" PRIu64 " %" PRIu64 " %u %s\n", id, total[id].m_evals,
+                    total[id].m_iterations, total[id].m_maxIterations, total[id].m_namep);
+        }
+    }
+    // Coroutine frame allocations over the collection window, only present with timing
+    if (m_frameCountsCb) {
+        const VlCoroutineFrameCounts counts = m_frameCountsCb();
+        fprintf(fp, "VLPROF stat frame-allocs %" PRIu64 "\n",
+                counts.m_allocs - m_frameCountsBegin.m_allocs);
+        fprintf(fp, "VLPROF stat frame-reuses %" PRIu64 "\n",
+                counts.m_reuses - m_frameCountsBegin.m_reuses);
+        fprintf(fp, "VLPROF stat frame-bytes %" PRIu64 "\n",
+                counts.m_bytes - m_frameCountsBegin.m_bytes);
+    }
+    // Histograms of MTask dependency wait times, by policy and log2(ticks)
+    for (int i = 0; i < static_cast<int>(VerilatedThreadsWait::_ENUM_END); ++i) {
+        const VerilatedThreadsWait policy = static_cast<VerilatedThreadsWait>(i);
+        for (size_t bucket = 0; bucket < VlMTaskVertex::WAIT_BUCKETS; ++bucket) {
+            const uint64_t count = VlMTaskVertex::waitHistogram(policy, bucket);
+            if (!count) continue;
+            fprintf(fp, "VLPROFWAIT %s %zu %" PRIu64 "\n",
+                    VerilatedContext::threadsWaitName(policy), bucket, count);
+        }
+    }
 
     // Copy /proc/cpuinfo into this output so verilator_gantt can be run on
     // a different machine
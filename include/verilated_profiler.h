@@ -29,6 +29,7 @@
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -43,6 +44,14 @@ class VlThreadPool;
     if (VL_UNLIKELY((vlSymsp)->__Vm_executionProfilerp->enabled())) \
     (vlSymsp)->__Vm_executionProfilerp->addRecord()
 
+#define VL_EXEC_GATE_COUNT(vlSymsp, skipped) \
+    if (VL_UNLIKELY((vlSymsp)->__Vm_executionProfilerp->enabled())) \
+    VlExecutionProfiler::gateCount(skipped)
+
+#define VL_EXEC_SETTLE_COUNT(vlSymsp, id, namep, iterations) \
+    if (VL_UNLIKELY((vlSymsp)->__Vm_executionProfilerp->enabled())) \
+    VlExecutionProfiler::settleCount((id), (namep), (iterations))
+
 //=============================================================================
 // Return high-precision counter for profiling, or 0x0 if not available
 VL_ATTR_ALWINLINE QData VL_CPU_TICK() {
@@ -129,6 +138,17 @@ public:
 static_assert(std::is_trivially_destructible<VlExecutionRecord>::value,
               "VlExecutionRecord should be trivially destructible for fast buffer clearing");
 
+//=============================================================================
+// Counts of coroutine frame allocations (--timing), see VlCoroutineFramePool
+
+struct VlCoroutineFrameCounts final {
+    uint64_t m_allocs = 0;  // Number of frames allocated
+    uint64_t m_reuses = 0;  // Number of frames allocated by reusing a freed frame
+    uint64_t m_bytes = 0;  // Total size of frames allocated
+};
+// Returns frame allocation counts summed over all threads
+using VlCoroutineFrameCountsCb = VlCoroutineFrameCounts (*)();
+
 //=============================================================================
 // VlExecutionProfiler is for collecting profiling data about model execution
 
@@ -149,18 +169,41 @@ class VlExecutionProfiler final : public VerilatedVirtualBase {
     // verilated.cpp top.
     using ExecutionTrace = std::vector<VlExecutionRecord>;
 
+    // Counts of activity gated (--activity-gating) function calls, also kept per thread
+    struct GateCounts final {
+        uint64_t m_evals = 0;  // Number of gated functions that were evaluated
+        uint64_t m_skips = 0;  // Number of gated functions skipped as their inputs were unchanged
+    };
+    // Counts of combinational loop settling (-fsched-scc-settle), kept per thread, by loop id
+    struct SettleCounts final {
+        const char* m_namep = nullptr;  // Source location of the loop
+        uint64_t m_evals = 0;  // Number of times the loop was settled
+        uint64_t m_iterations = 0;  // Total number of iterations
+        uint32_t m_maxIterations = 0;  // Maximum number of iterations to settle
+    };
+
     // STATE
     VerilatedContext& m_context;  // The context this profiler is under
     static thread_local ExecutionTrace t_trace;  // thread-local trace buffers
     mutable VerilatedMutex m_mutex;
     // Map from thread id to &t_trace of given thread
     std::map<uint32_t, ExecutionTrace*> m_traceps VL_GUARDED_BY(m_mutex);
+    static thread_local GateCounts t_gateCounts;  // thread-local gating counts
+    // Map from thread id to &t_gateCounts of given thread
+    std::map<uint32_t, GateCounts*> m_gateCountps VL_GUARDED_BY(m_mutex);
+    static thread_local std::vector<SettleCounts> t_settleCounts;  // thread-local settle counts
+    // Map from thread id to &t_settleCounts of given thread
+    std::map<uint32_t, std::vector<SettleCounts>*> m_settleCountps VL_GUARDED_BY(m_mutex);
+    VlCoroutineFrameCountsCb m_frameCountsCb = nullptr;  // Frame counts callback, if timing
+    VlCoroutineFrameCounts m_frameCountsBegin;  // Frame counts at beginning of collection
 
     bool m_enabled = false;  // Is profiling currently enabled
 
     uint64_t m_tickBegin = 0;  // Sample time (rdtsc() on x86) at beginning of collection
+    std::chrono::steady_clock::time_point m_wallBegin;  // Wall time at beginning of collection
     uint64_t m_lastStartReq = 0;  // Last requested profiling start (in simulation time)
     uint32_t m_windowCount = 0;  // Track our position in the cache warmup and profile window
+    uint64_t m_evalCount = 0;  // Number of evaluations in the profile window
 
 public:
     // CONSTRUCTOR
@@ -176,6 +219,25 @@ public:
         t_trace.emplace_back();
         return t_trace.back();
     }
+    // Count an activity gated function call on the current thread
+    static void gateCount(bool skipped) {
+        if (skipped) {
+            ++t_gateCounts.m_skips;
+        } else {
+            ++t_gateCounts.m_evals;
+        }
+    }
+    // Count the iterations of settling a combinational loop on the current thread
+    static void settleCount(uint32_t id, const char* namep, uint32_t iterations) {
+        if (VL_UNLIKELY(id >= t_settleCounts.size())) t_settleCounts.resize(id + 1);
+        SettleCounts& counts = t_settleCounts[id];
+        counts.m_namep = namep;
+        ++counts.m_evals;
+        counts.m_iterations += iterations;
+        if (iterations > counts.m_maxIterations) counts.m_maxIterations = iterations;
+    }
+    // Set the callback returning coroutine frame allocation counts
+    void frameCountsCb(VlCoroutineFrameCountsCb cb) { m_frameCountsCb = cb; }
     // Configure profiler (called in beginning of 'eval')
     void configure();
     // Setup profiling on a particular thread;
@@ -183,7 +245,8 @@ public:
     // Clear all profiling data
     void clear() VL_MT_SAFE_EXCLUDES(m_mutex);
     // Write profiling data into file
-    void dump(const char* filenamep, uint64_t tickEnd) VL_MT_SAFE_EXCLUDES(m_mutex);
+    void dump(const char* filenamep, uint64_t tickEnd,
+              std::chrono::steady_clock::time_point wallEnd) VL_MT_SAFE_EXCLUDES(m_mutex);
 
     // Passed to VerilatedContext to create the VlExecutionProfiler profiler instance
     static VerilatedVirtualBase* construct(VerilatedContext& context);
@@ -25,16 +25,40 @@
 
 #include "verilated_threads.h"
 
+#include <algorithm>
+#include <cctype>
 #include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <memory>
+#include <sstream>
 #include <string>
 
+// clang-format off
+#if defined(__linux)
+# include <pthread.h>
+# include <sched.h>
+#endif
+// clang-format on
+
 //=============================================================================
 // Globals
 
 // Internal note: Globals may multi-construct, see verilated.cpp top.
 
 std::atomic<uint64_t> VlMTaskVertex::s_yields;
+std::atomic<uint64_t> VlMTaskVertex::s_parks;
+std::atomic<uint32_t> VlMTaskVertex::s_parked;
+std::atomic<uint64_t> VlMTaskVertex::s_waitHist[VlMTaskVertex::N_POLICIES]
+                                               [VlMTaskVertex::WAIT_BUCKETS];
+std::atomic<bool> VlMTaskVertex::s_waitHistOn{false};
+constexpr size_t VlMTaskVertex::WAIT_BUCKETS;
+constexpr size_t VlMTaskVertex::N_POLICIES;
+constexpr uint32_t VlMTaskVertex::ADAPTIVE_SPINS_MIN;
+constexpr uint32_t VlMTaskVertex::ADAPTIVE_SPINS_MAX;
+
+thread_local VlWorkStealingDeque* VlThreadPool::t_dequep = nullptr;
+VerilatedMutex VlThreadPool::s_dispatchMutex;
 
 //=============================================================================
 // VlMTaskVertex
@@ -45,12 +69,123 @@ VlMTaskVertex::VlMTaskVertex(uint32_t upstreamDepCount)
     assert(atomic_is_lock_free(&m_upstreamDepsDone));
 }
 
+namespace {
+// Threads parked on a vertex sleep in the bucket the vertex address hashes to.
+// Waiters are rare (one per vertex, and only after spinning), so a small fixed
+// table is enough; a collision only costs a spurious wakeup.
+struct VlParkingBucket final {
+    VerilatedMutex m_mutex;
+    std::condition_variable_any m_cv;
+};
+constexpr size_t VL_PARKING_BUCKETS = 64;
+
+VlParkingBucket& parkingBucket(const void* addrp) {
+    static VlParkingBucket s_buckets[VL_PARKING_BUCKETS];
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(addrp);
+    return s_buckets[(addr >> 6) % VL_PARKING_BUCKETS];
+}
+
+size_t log2Bucket(uint64_t ticks) {
+    size_t bucket = 0;
+    while (ticks >>= 1) ++bucket;
+    return bucket;
+}
+}  // namespace
+
+void VlMTaskVertex::waitHistogramStart() {
+    for (auto& hist : s_waitHist) {
+        for (std::atomic<uint64_t>& count : hist) count.store(0, std::memory_order_relaxed);
+    }
+    s_waitHistOn.store(true, std::memory_order_relaxed);
+}
+
+void VlMTaskVertex::waitUntilUpstreamDoneSlow(bool evenCycle) const {
+    const VerilatedThreadsWait policy = Verilated::threadContextp()->threadsWait();
+    const bool histOn = s_waitHistOn.load(std::memory_order_relaxed);
+    uint64_t startTick = 0;
+    if (VL_UNLIKELY(histOn)) VL_GET_CPU_TICK(startTick);
+    switch (policy) {
+    case VerilatedThreadsWait::SPIN: {
+        while (VL_UNLIKELY(!areUpstreamDepsDone(evenCycle))) VL_CPU_RELAX();
+        break;
+    }
+    case VerilatedThreadsWait::PARK:
+    case VerilatedThreadsWait::ADAPTIVE: {
+        const bool adaptive = policy == VerilatedThreadsWait::ADAPTIVE;
+        const uint32_t limit = adaptive ? m_spinLimit : VL_LOCK_SPINS;
+        uint32_t ct = 0;
+        while (!areUpstreamDepsDone(evenCycle) && ct < limit) {
+            VL_CPU_RELAX();
+            ++ct;
+        }
+        if (ct < limit) {
+            // Spinning paid off; aim for twice what it took, averaged over 8 waits
+            if (adaptive) {
+                const uint32_t target = std::min(ADAPTIVE_SPINS_MAX, std::max(2 * ct, 1U));
+                m_spinLimit = std::max(ADAPTIVE_SPINS_MIN,
+                                       m_spinLimit - m_spinLimit / 8 + target / 8);
+            }
+        } else {
+            parkUntilUpstreamDone(evenCycle);
+            // Spinning was wasted; shrink the budget
+            if (adaptive) m_spinLimit = std::max(ADAPTIVE_SPINS_MIN, limit - limit / 8);
+        }
+        break;
+    }
+    default: {  // SPIN_YIELD
+        unsigned ct = 0;
+        while (VL_UNLIKELY(!areUpstreamDepsDone(evenCycle))) {
+            VL_CPU_RELAX();
+            ++ct;
+            if (VL_UNLIKELY(ct > VL_LOCK_SPINS)) {
+                ct = 0;
+                yieldThread();
+            }
+        }
+        break;
+    }
+    }
+    if (VL_UNLIKELY(histOn)) {
+        uint64_t endTick;
+        VL_GET_CPU_TICK(endTick);
+        s_waitHist[static_cast<size_t>(policy)][log2Bucket(endTick - startTick)].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+}
+
+void VlMTaskVertex::parkUntilUpstreamDone(bool evenCycle) const {
+    ++s_parks;  // Statistics
+    VlParkingBucket& bucket = parkingBucket(this);
+    VerilatedLockGuard lock{bucket.m_mutex};
+    // Publish that we are parked before the final check, pairing with the
+    // load in signalUpstreamDone, so either we see the last upstream update
+    // or the signalling thread sees us and notifies under the bucket lock.
+    s_parked.fetch_add(1);
+    while (!areUpstreamDepsDone(evenCycle)) bucket.m_cv.wait(bucket.m_mutex);
+    s_parked.fetch_sub(1);
+}
+
+void VlMTaskVertex::unparkWaiters() const {
+    VlParkingBucket& bucket = parkingBucket(this);
+    // Taking the lock ensures the waiter is either blocked in wait, or has
+    // not yet made its final check (and will then see the update)
+    { const VerilatedLockGuard lock{bucket.m_mutex}; }
+    bucket.m_cv.notify_all();
+}
+
 //=============================================================================
 // VlWorkerThread
 
-VlWorkerThread::VlWorkerThread(VerilatedContext* contextp)
-    : m_ready_size{0}
-    , m_cthread{startWorker, this, contextp} {}
+constexpr size_t VlWorkerThread::READY_CAPACITY;
+
+VlWorkerThread::VlWorkerThread(VerilatedContext* contextp, int cpu) {
+    // Slot 'i' is free for the producer that claims position 'i'
+    for (size_t i = 0; i < READY_CAPACITY; ++i) {
+        m_ready[i].m_seq.store(i, std::memory_order_relaxed);
+    }
+    // Start the thread only once the ring is initialized
+    m_cthread = std::thread{startWorker, this, contextp, cpu};
+}
 
 VlWorkerThread::~VlWorkerThread() {
     shutdown();
@@ -85,25 +220,288 @@ void VlWorkerThread::workerLoop() {
 
     while (true) {
         if (VL_UNLIKELY(work.m_fnp == shutdownTask)) break;
+        if (work.m_contextp && VL_UNLIKELY(work.m_contextp != Verilated::threadContextp())) {
+            Verilated::threadContextp(work.m_contextp);
+        }
         work.m_fnp(work.m_selfp, work.m_evenCycle);
         // Wait for next task with spinning.
         dequeWork</* SpinWait: */ true>(&work);
     }
 }
 
-void VlWorkerThread::startWorker(VlWorkerThread* workerp, VerilatedContext* contextp) {
-    Verilated::threadContextp(contextp);
+void VlWorkerThread::startWorker(VlWorkerThread* workerp, VerilatedContext* contextp,
+                                 int cpu) {
+    // Pin before the thread touches any memory, so its stack and buffers are node local
+    if (cpu >= 0) workerp->m_pinned.store(VlThreadPool::pinThread(cpu));
+    // Shared workers have no context of their own, each task brings one
+    if (contextp) Verilated::threadContextp(contextp);
     workerp->workerLoop();
 }
 
 //=============================================================================
 // VlThreadPool
 
-VlThreadPool::VlThreadPool(VerilatedContext* contextp, unsigned nThreads) {
-    for (unsigned i = 0; i < nThreads; ++i) m_workers.push_back(new VlWorkerThread{contextp});
+namespace {
+// Parse a CPU list such as "0-3,8", in the format of taskset and /sys.
+// Returns false if the list is malformed.
+bool parseCpuList(const std::string& list, std::vector<int>& cpus) {
+    // Beyond any CPU number, also bounds the size of a range
+    static constexpr long MAX_CPU = 1 << 16;
+    const auto parseNum = [](const char*& strp, long& value) {
+        if (!std::isdigit(static_cast<unsigned char>(*strp))) return false;
+        char* endp;
+        value = std::strtol(strp, &endp, 10);
+        strp = endp;
+        return value <= MAX_CPU;
+    };
+    std::istringstream is{list};
+    std::string range;
+    while (std::getline(is, range, ',')) {
+        if (range.empty()) continue;
+        const char* strp = range.c_str();
+        long lo;
+        if (!parseNum(strp, lo)) return false;
+        long hi = lo;
+        if (*strp == '-') {
+            ++strp;
+            if (!parseNum(strp, hi) || hi < lo) return false;
+        }
+        if (*strp) return false;
+        for (long cpu = lo; cpu <= hi; ++cpu) cpus.push_back(static_cast<int>(cpu));
+    }
+    return true;
+}
+
+#if defined(__linux)
+std::string readFirstLine(const std::string& filename) {
+    std::ifstream ifs{filename};
+    std::string line;
+    std::getline(ifs, line);
+    return line;
+}
+
+// CPU list from /sys, empty if unavailable
+std::vector<int> parseSysCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    if (!parseCpuList(list, cpus)) cpus.clear();
+    return cpus;
+}
+
+// CPUs we may run on, starting with the NUMA node of the calling thread.
+// Within each node the first hyperthread of each core comes first, so
+// threads only share a core once every core of the node is in use.
+std::vector<int> numaCpus() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed)) return {};
+    const int here = sched_getcpu();
+    std::vector<std::vector<int>> nodes;
+    for (const int node : parseSysCpuList(readFirstLine("/sys/devices/system/node/online"))) {
+        const std::string filename
+            = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+        std::vector<int> nodeCpus = parseSysCpuList(readFirstLine(filename));
+        if (std::find(nodeCpus.begin(), nodeCpus.end(), here) != nodeCpus.end()) {
+            nodes.insert(nodes.begin(), std::move(nodeCpus));
+        } else {
+            nodes.push_back(std::move(nodeCpus));
+        }
+    }
+    if (nodes.empty()) {  // No NUMA information, treat as a single node
+        nodes.emplace_back();
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) nodes.back().push_back(cpu);
+    }
+    std::vector<int> cpus;
+    for (const std::vector<int>& nodeCpus : nodes) {
+        std::vector<int> siblings;
+        for (const int cpu : nodeCpus) {
+            if (cpu < 0 || cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed)) continue;
+            const std::vector<int> coreCpus
+                = parseSysCpuList(readFirstLine("/sys/devices/system/cpu/cpu"
+                                                + std::to_string(cpu)
+                                                + "/topology/thread_siblings_list"));
+            if (coreCpus.empty() || coreCpus.front() == cpu) {
+                cpus.push_back(cpu);
+            } else {
+                siblings.push_back(cpu);
+            }
+        }
+        cpus.insert(cpus.end(), siblings.begin(), siblings.end());
+    }
+    return cpus;
+}
+#endif
+}  // namespace
+
+bool VlThreadPool::pinThread(int cpu) {
+#if defined(__linux)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    return !pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+#else
+    return false;
+#endif
+}
+
+std::vector<int> VlThreadPool::affinityCpus(const std::string& affinity, unsigned nThreads) {
+    if (affinity.empty()) return {};
+    std::vector<int> cpus;
+#if defined(__linux)
+    if (affinity == "numa") cpus = numaCpus();
+#endif
+    if (affinity != "numa" && !parseCpuList(affinity, cpus)) {
+        const std::string msg = "Unknown +verilator+threads+affinity+ value: '" + affinity
+                                + "', suggest a CPU list such as '0-3,8', or 'numa'";
+        VL_FATAL_MT("COMMAND_LINE", 0, "", msg.c_str());
+    }
+    if (cpus.empty()) {
+        VL_PRINTF_MT("%%Warning: No CPUs found for +verilator+threads+affinity+%s, "
+                     "not pinning simulation threads\n",
+                     affinity.c_str());
+        return {};
+    }
+    // More threads than CPUs wraps around
+    std::vector<int> result;
+    for (unsigned i = 0; i <= nThreads; ++i) result.push_back(cpus[i % cpus.size()]);
+    return result;
+}
+
+std::vector<VlWorkerThread*> VlThreadPool::sharedWorkers(VerilatedContext* contextp,
+                                                         unsigned nThreads) {
+    struct Shared final {
+        VerilatedMutex m_mutex;
+        std::vector<VlWorkerThread*> m_workers VL_GUARDED_BY(m_mutex);
+        size_t m_next VL_GUARDED_BY(m_mutex) = 0;  // First worker of the next pool
+        ~Shared() {
+            for (VlWorkerThread* const workerp : m_workers) delete workerp;
+        }
+    };
+    static Shared s_shared;
+    const VerilatedLockGuard lock{s_shared.m_mutex};
+    std::vector<VlWorkerThread*>& workers = s_shared.m_workers;
+    // Start with a worker per hardware thread, beside the evaluating threads, so
+    // pools with small quotas can be spread over the whole machine.
+    const unsigned hwThreads = std::thread::hardware_concurrency();
+    const size_t minWorkers = std::max<size_t>(nThreads, hwThreads > 1 ? hwThreads - 1 : 1);
+    if (workers.size() < minWorkers) {
+        const std::vector<int> cpus = affinityCpus(contextp->threadsAffinity(), minWorkers);
+        for (size_t i = workers.size(); i < minWorkers; ++i) {
+            workers.push_back(new VlWorkerThread{nullptr, cpus.empty() ? -1 : cpus[i + 1]});
+        }
+    }
+    // Successive pools start at successive workers, so contexts interleave evenly
+    std::vector<VlWorkerThread*> result;
+    for (unsigned i = 0; i < nThreads; ++i) {
+        result.push_back(workers[(s_shared.m_next + i) % workers.size()]);
+    }
+    s_shared.m_next = (s_shared.m_next + nThreads) % workers.size();
+    return result;
+}
+
+VlThreadPool::VlThreadPool(VerilatedContext* contextp, unsigned nThreads, bool shared)
+    : m_contextp{contextp}
+    , m_shared{shared} {
+    if (m_shared) {
+        // Shared workers are pinned when created; the evaluating threads of
+        // the contexts sharing them are left alone
+        m_workers = sharedWorkers(contextp, nThreads);
+    } else {
+        const std::vector<int> cpus = affinityCpus(contextp->threadsAffinity(), nThreads);
+        if (!cpus.empty()) {
+            // The creating thread is thread 0, which evaluates the model. With
+            // "numa" it stays on its current node, so model state it already
+            // first-touched remains local to all simulation threads.
+            m_pinned = pinThread(cpus[0]);
+            if (!m_pinned) {
+                VL_PRINTF_MT("%%Warning: Cannot pin to CPU %d for "
+                             "+verilator+threads+affinity+%s, not pinning simulation threads\n",
+                             cpus[0], contextp->threadsAffinity().c_str());
+            }
+        }
+        for (unsigned i = 0; i < nThreads; ++i) {
+            m_workers.push_back(new VlWorkerThread{contextp, m_pinned ? cpus[i + 1] : -1});
+        }
+    }
+    // One deque per worker, plus one for the thread calling executeDynamic
+    for (unsigned i = 0; i <= nThreads; ++i) m_deques.push_back(new VlWorkStealingDeque);
+}
+
+bool VlThreadPool::pinned() const {
+    bool pinned = m_shared ? !m_workers.empty() : m_pinned;
+    for (const VlWorkerThread* const workerp : m_workers) pinned = pinned && workerp->pinned();
+    return pinned;
 }
 
 VlThreadPool::~VlThreadPool() {
     // Each ~WorkerThread will wait for its thread to exit.
-    for (auto& i : m_workers) delete i;
+    if (!m_shared) {
+        for (auto& i : m_workers) delete i;
+    }
+    for (auto& i : m_deques) delete i;
+}
+
+struct VlThreadPool::DynamicExec final {
+    VlThreadPool* const m_poolp;  // Pool executing
+    const VlMTaskVertex& m_finalr;  // Done when all its upstream dependencies are done
+    const bool m_evenCycle;  // Even/odd for m_finalr
+    std::atomic<size_t> m_nextIndex{1};  // Next deque index to hand out, 0 is the caller's
+    std::atomic<int> m_pendingHelpers;  // Workers still referencing this structure
+    DynamicExec(VlThreadPool* poolp, const VlMTaskVertex& finalr, bool evenCycle, int helpers)
+        : m_poolp{poolp}
+        , m_finalr{finalr}
+        , m_evenCycle{evenCycle}
+        , m_pendingHelpers{helpers} {}
+};
+
+void VlThreadPool::runDynamic(DynamicExec& exec, size_t index) {
+    const size_t nDeques = m_deques.size();
+    VlWorkStealingDeque* const ownp = m_deques[index % nDeques];
+    VlWorkStealingDeque* const prevDequep = t_dequep;
+    t_dequep = ownp;
+    VlExecRec work;
+    unsigned idle = 0;
+    while (!exec.m_finalr.areUpstreamDepsDone(exec.m_evenCycle)) {
+        bool found = ownp->pop(&work);
+        // Nothing local, try to steal, starting from our neighbour
+        for (size_t i = 1; !found && i < nDeques; ++i) {
+            found = m_deques[(index + i) % nDeques]->steal(&work);
+        }
+        if (found) {
+            work.m_fnp(work.m_selfp, work.m_evenCycle);
+            idle = 0;
+        } else {
+            VL_CPU_RELAX();
+            if (VL_UNLIKELY(++idle > VL_LOCK_SPINS)) {
+                idle = 0;
+                VlMTaskVertex::yieldThread();
+            }
+        }
+    }
+    t_dequep = prevDequep;
+}
+
+void VlThreadPool::dynamicHelper(VlSelfP execp, bool) {
+    DynamicExec& exec = *static_cast<DynamicExec*>(execp);
+    const size_t index = exec.m_nextIndex.fetch_add(1, std::memory_order_relaxed);
+    exec.m_poolp->runDynamic(exec, index);
+    exec.m_pendingHelpers.fetch_sub(1, std::memory_order_release);
+}
+
+void VlThreadPool::executeDynamic(const VlMTaskVertex& finalr, bool evenCycle) {
+    DynamicExec exec{this, finalr, evenCycle, numThreads()};
+    for (VlWorkerThread* const workerp : m_workers) {
+        workerp->addTask(dynamicHelper, &exec, false, m_shared ? m_contextp : nullptr);
+    }
+    runDynamic(exec, 0);
+    // 'exec' lives on our stack, so wait until no helper can still look at it.
+    // Helpers leave as soon as they see the graph completed.
+    unsigned ct = 0;
+    while (exec.m_pendingHelpers.load(std::memory_order_acquire)) {
+        VL_CPU_RELAX();
+        if (VL_UNLIKELY(++ct > VL_LOCK_SPINS)) {
+            ct = 0;
+            VlMTaskVertex::yieldThread();
+        }
+    }
 }
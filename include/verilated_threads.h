@@ -29,6 +29,8 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <set>
 #include <thread>
 #include <vector>
@@ -54,8 +56,25 @@ using VlExecFnp = void (*)(VlSelfP, bool);
 
 // Track dependencies for a single MTask.
 class VlMTaskVertex final {
+public:
+    // CONSTANTS
+    static constexpr size_t WAIT_BUCKETS = 64;  // Wait histogram buckets, log2 of CPU ticks
+
+private:
+    // TYPES
+    static constexpr size_t N_POLICIES = static_cast<size_t>(VerilatedThreadsWait::_ENUM_END);
+    // ADAPTIVE spin limits, in VL_CPU_RELAX iterations
+    static constexpr uint32_t ADAPTIVE_SPINS_MIN = 64;
+    static constexpr uint32_t ADAPTIVE_SPINS_MAX = VL_LOCK_SPINS;
+
     // MEMBERS
     static std::atomic<uint64_t> s_yields;  // Statistics
+    static std::atomic<uint64_t> s_parks;  // Statistics
+    static std::atomic<uint32_t> s_parked;  // Number of threads currently parked
+    // Statistics: Histogram of slow path wait times per policy, only
+    // collected during the profiling window
+    static std::atomic<uint64_t> s_waitHist[N_POLICIES][WAIT_BUCKETS];
+    static std::atomic<bool> s_waitHistOn;  // Collecting s_waitHist
 
     // On even cycles, _upstreamDepsDone increases as upstream
     // dependencies complete. When it reaches _upstreamDepCount,
@@ -75,6 +94,9 @@ class VlMTaskVertex final {
     // use 16-bit types here...)
     std::atomic<uint32_t> m_upstreamDepsDone;
     const uint32_t m_upstreamDepCount;
+    // Learned spin limit for VerilatedThreadsWait::ADAPTIVE. Only the one
+    // thread running the dependent MTask ever waits on a given vertex.
+    mutable uint32_t m_spinLimit = ADAPTIVE_SPINS_MIN;
 
 public:
     // CONSTRUCTORS
@@ -86,6 +108,14 @@ public:
     ~VlMTaskVertex() = default;
 
     static uint64_t yields() { return s_yields; }
+    static uint64_t parks() { return s_parks; }
+    static uint64_t waitHistogram(VerilatedThreadsWait policy, size_t bucket) {
+        return s_waitHist[static_cast<size_t>(policy)][bucket].load(std::memory_order_relaxed);
+    }
+    // Clear the wait histogram and start collecting it
+    static void waitHistogramStart();
+    // Stop collecting the wait histogram
+    static void waitHistogramStop() { s_waitHistOn.store(false, std::memory_order_relaxed); }
     static void yieldThread() {
         ++s_yields;  // Statistics
         std::this_thread::yield();
@@ -95,69 +125,125 @@ public:
     // Returns true when the current MTaskVertex becomes ready to execute,
     // false while it's still waiting on more dependencies.
     bool signalUpstreamDone(bool evenCycle) {
+        // The read-modify-write and the s_parked load are sequentially
+        // consistent, pairing with the same in parkUntilUpstreamDone, so a
+        // parking waiter either sees the update or is seen as parked.
+        bool ready;
         if (evenCycle) {
-            const uint32_t upstreamDepsDone
-                = 1 + m_upstreamDepsDone.fetch_add(1, std::memory_order_release);
+            const uint32_t upstreamDepsDone = 1 + m_upstreamDepsDone.fetch_add(1);
             assert(upstreamDepsDone <= m_upstreamDepCount);
-            return (upstreamDepsDone == m_upstreamDepCount);
+            ready = (upstreamDepsDone == m_upstreamDepCount);
         } else {
-            const uint32_t upstreamDepsDone_prev
-                = m_upstreamDepsDone.fetch_sub(1, std::memory_order_release);
+            const uint32_t upstreamDepsDone_prev = m_upstreamDepsDone.fetch_sub(1);
             assert(upstreamDepsDone_prev > 0);
-            return (upstreamDepsDone_prev == 1);
+            ready = (upstreamDepsDone_prev == 1);
         }
+        if (ready && VL_UNLIKELY(s_parked.load())) unparkWaiters();
+        return ready;
     }
     bool areUpstreamDepsDone(bool evenCycle) const {
         const uint32_t target = evenCycle ? m_upstreamDepCount : 0;
         return m_upstreamDepsDone.load(std::memory_order_acquire) == target;
     }
     void waitUntilUpstreamDone(bool evenCycle) const {
-        unsigned ct = 0;
-        while (VL_UNLIKELY(!areUpstreamDepsDone(evenCycle))) {
-            VL_CPU_RELAX();
-            ++ct;
-            if (VL_UNLIKELY(ct > VL_LOCK_SPINS)) {
-                ct = 0;
-                yieldThread();
-            }
-        }
+        if (VL_LIKELY(areUpstreamDepsDone(evenCycle))) return;
+        waitUntilUpstreamDoneSlow(evenCycle);
     }
+
+private:
+    // Wait according to the current thread's VerilatedContext::threadsWait()
+    void waitUntilUpstreamDoneSlow(bool evenCycle) const;
+    void parkUntilUpstreamDone(bool evenCycle) const;
+    void unparkWaiters() const;
+};
+
+// A unit of work handed to a thread
+struct VlExecRec final {
+    VlExecFnp m_fnp = nullptr;  // Function to execute
+    VlSelfP m_selfp = nullptr;  // Symbol table to execute
+    bool m_evenCycle = false;  // Even/odd for flag alternation
+    // Context to execute under, for workers shared between contexts, else nullptr
+    VerilatedContext* m_contextp = nullptr;
+    VlExecRec() = default;
+    VlExecRec(VlExecFnp fnp, VlSelfP selfp, bool evenCycle, VerilatedContext* contextp)
+        : m_fnp{fnp}
+        , m_selfp{selfp}
+        , m_evenCycle{evenCycle}
+        , m_contextp{contextp} {}
 };
 
 class VlWorkerThread final {
 private:
     // TYPES
-    struct ExecRec {
-        VlExecFnp m_fnp = nullptr;  // Function to execute
-        VlSelfP m_selfp = nullptr;  // Symbol table to execute
-        bool m_evenCycle = false;  // Even/odd for flag alternation
-        ExecRec() = default;
-        ExecRec(VlExecFnp fnp, VlSelfP selfp, bool evenCycle)
-            : m_fnp{fnp}
-            , m_selfp{selfp}
-            , m_evenCycle{evenCycle} {}
+    using ExecRec = VlExecRec;
+
+    // A slot in the ready ring. 'm_seq' tells producers and the consumer whose
+    // turn it is to touch 'm_rec' (bounded MPSC queue after D. Vyukov).
+    struct Slot {
+        std::atomic<size_t> m_seq;  // Sequence number of the slot
+        ExecRec m_rec;  // The task record
     };
 
+    // CONSTANTS
+    // The generated code enqueues one task per worker per evaluated exec graph,
+    // so the ring is normally nearly empty. Producers spin if it ever fills.
+    static constexpr size_t READY_CAPACITY = 256;  // Must be a power of 2
+    static_assert((READY_CAPACITY & (READY_CAPACITY - 1)) == 0, "Must be power of 2");
+
     // MEMBERS
+    // The ring sits between the producer and consumer positions, which keeps
+    // those two on separate cache lines.
+    std::atomic<size_t> m_enqPos{0};  // Next position producers will write
+    // Ready ring, written by any number of producers, consumed only by this worker
+    Slot m_ready[READY_CAPACITY];
+    size_t m_deqPos = 0;  // Next position the worker will read (worker thread only)
+
+    // Parking. The worker only takes the mutex when the ring has stayed empty
+    // for a full spin, and producers only take it when the worker is parked.
     mutable VerilatedMutex m_mutex;
     std::condition_variable_any m_cv;
-    // Only notify the condition_variable if the worker is waiting
-    bool m_waiting VL_GUARDED_BY(m_mutex) = false;
-
-    // Why a vector? We expect the pending list to be very short, typically
-    // 0 or 1 or 2, so popping from the front shouldn't be
-    // expensive. Revisit if we ever have longer queues...
-    std::vector<ExecRec> m_ready VL_GUARDED_BY(m_mutex);
-    // Store the size atomically, so we can spin wait
-    std::atomic<size_t> m_ready_size;
+    std::atomic<bool> m_waiting{false};  // Worker is (about to be) parked on m_cv
 
     std::thread m_cthread;  // Underlying C++ thread record
+    std::atomic<bool> m_pinned{false};  // Thread is pinned to the CPU it was created for
 
     VL_UNCOPYABLE(VlWorkerThread);
 
+    // Pop the next task if there is one. Only called by the worker thread.
+    bool tryDequeWork(ExecRec* workp) {
+        Slot& slot = m_ready[m_deqPos & (READY_CAPACITY - 1)];
+        if (slot.m_seq.load(std::memory_order_acquire) != m_deqPos + 1) return false;
+        *workp = slot.m_rec;
+        slot.m_seq.store(m_deqPos + READY_CAPACITY, std::memory_order_release);
+        ++m_deqPos;
+        return true;
+    }
+    // Push a task. Returns false if the ring is full. Called by any thread.
+    bool tryEnqueWork(VlExecFnp fnp, VlSelfP selfp, bool evenCycle,
+                      VerilatedContext* contextp) {
+        size_t pos = m_enqPos.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = m_ready[pos & (READY_CAPACITY - 1)];
+            const size_t seq = slot.m_seq.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.m_rec = ExecRec{fnp, selfp, evenCycle, contextp};
+                    slot.m_seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = m_enqPos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
 public:
     // CONSTRUCTORS
-    explicit VlWorkerThread(VerilatedContext* contextp);
+    // 'cpu' is the CPU to pin the thread to, or -1 to let the OS schedule it
+    VlWorkerThread(VerilatedContext* contextp, int cpu);
     ~VlWorkerThread();
 
     // METHODS
@@ -166,62 +252,165 @@ public:
         // Spin for a while, waiting for new data
         if VL_CONSTEXPR_CXX17 (SpinWait) {
             for (unsigned i = 0; i < VL_LOCK_SPINS; ++i) {
-                if (VL_LIKELY(m_ready_size.load(std::memory_order_relaxed))) break;
+                if (VL_LIKELY(tryDequeWork(workp))) return;
                 VL_CPU_RELAX();
             }
         }
+        if (tryDequeWork(workp)) return;
+        // Park until a producer wakes us. 'm_waiting' is published before the final
+        // emptiness check, and producers check it after publishing their task, so
+        // at least one side always sees the other.
         VerilatedLockGuard lock{m_mutex};
-        while (m_ready.empty()) {
-            m_waiting = true;
-            m_cv.wait(m_mutex);
-        }
-        m_waiting = false;
-        // As noted above this is inefficient if our ready list is ever
-        // long (but it shouldn't be)
-        *workp = m_ready.front();
-        m_ready.erase(m_ready.begin());
-        m_ready_size.fetch_sub(1, std::memory_order_relaxed);
+        m_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!tryDequeWork(workp)) m_cv.wait(m_mutex);
+        m_waiting.store(false, std::memory_order_relaxed);
     }
-    void addTask(VlExecFnp fnp, VlSelfP selfp, bool evenCycle = false)
-        VL_MT_SAFE_EXCLUDES(m_mutex) {
-        bool notify;
-        {
-            const VerilatedLockGuard lock{m_mutex};
-            m_ready.emplace_back(fnp, selfp, evenCycle);
-            m_ready_size.fetch_add(1, std::memory_order_relaxed);
-            notify = m_waiting;
+    // 'contextp' if not nullptr becomes the thread's context before executing the task
+    void addTask(VlExecFnp fnp, VlSelfP selfp, bool evenCycle = false,
+                 VerilatedContext* contextp = nullptr) VL_MT_SAFE_EXCLUDES(m_mutex) {
+        while (VL_UNLIKELY(!tryEnqueWork(fnp, selfp, evenCycle, contextp))) {
+            std::this_thread::yield();
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (VL_UNLIKELY(m_waiting.load(std::memory_order_relaxed))) {
+            // Taking the mutex ensures the worker is either blocked in m_cv.wait,
+            // or has not yet done its final check, which will then see the task.
+            { const VerilatedLockGuard lock{m_mutex}; }
+            m_cv.notify_one();
         }
-        if (notify) m_cv.notify_one();
     }
 
+    // Thread is pinned to the CPU it was created for
+    bool pinned() const { return m_pinned.load(std::memory_order_relaxed); }
+
     void shutdown();  // Finish current tasks, then terminate thread
     void wait();  // Blocks calling thread until all tasks complete in this thread
 
     void workerLoop();
-    static void startWorker(VlWorkerThread* workerp, VerilatedContext* contextp);
+    static void startWorker(VlWorkerThread* workerp, VerilatedContext* contextp, int cpu);
+};
+
+// Ready list of one thread in dynamic (work stealing) MTask execution. The
+// owning thread pushes and pops at the back, other threads steal from the front.
+// Any thread may use any deque, ownership only matters for locality.
+class VlWorkStealingDeque final {
+    // MEMBERS
+    mutable VerilatedMutex m_mutex;
+    std::deque<VlExecRec> m_tasks VL_GUARDED_BY(m_mutex);
+    std::atomic<size_t> m_size{0};  // Size, so thieves can skip empty deques without locking
+
+public:
+    // METHODS
+    void push(VlExecFnp fnp, VlSelfP selfp, bool evenCycle) VL_MT_SAFE_EXCLUDES(m_mutex) {
+        const VerilatedLockGuard lock{m_mutex};
+        m_tasks.emplace_back(fnp, selfp, evenCycle, nullptr);
+        m_size.store(m_tasks.size(), std::memory_order_release);
+    }
+    bool pop(VlExecRec* workp) VL_MT_SAFE_EXCLUDES(m_mutex) {
+        if (!m_size.load(std::memory_order_acquire)) return false;
+        const VerilatedLockGuard lock{m_mutex};
+        if (m_tasks.empty()) return false;
+        *workp = m_tasks.back();
+        m_tasks.pop_back();
+        m_size.store(m_tasks.size(), std::memory_order_release);
+        return true;
+    }
+    bool steal(VlExecRec* workp) VL_MT_SAFE_EXCLUDES(m_mutex) {
+        if (!m_size.load(std::memory_order_acquire)) return false;
+        const VerilatedLockGuard lock{m_mutex};
+        if (m_tasks.empty()) return false;
+        *workp = m_tasks.front();
+        m_tasks.pop_front();
+        m_size.store(m_tasks.size(), std::memory_order_release);
+        return true;
+    }
 };
 
 class VlThreadPool final : public VerilatedVirtualBase {
+    // TYPES
+    struct DynamicExec;  // State of one executeDynamic call
+
     // MEMBERS
-    std::vector<VlWorkerThread*> m_workers;  // our workers
+    VerilatedContext* const m_contextp;  // Context owning this pool
+    std::vector<VlWorkerThread*> m_workers;  // our workers, owned unless m_shared
+    // Workers are shared with the pools of other contexts, see VerilatedContext::threadsShared
+    const bool m_shared;
+    // Ready deques for dynamic scheduling, one per participating thread
+    std::vector<VlWorkStealingDeque*> m_deques;
+    std::atomic<size_t> m_nextRootDeque{0};  // Round robin for tasks pushed from outside
+    // Deque of the current thread while it is executing dynamically scheduled MTasks
+    static thread_local VlWorkStealingDeque* t_dequep;
+    static VerilatedMutex s_dispatchMutex;  // Serializes dispatch to shared workers
+    bool m_pinned = false;  // Creating thread is pinned, per VerilatedContext::threadsAffinity
 
 public:
     // CONSTRUCTORS
     // Construct a thread pool with 'nThreads' dedicated threads. The thread
     // pool will create these threads and make them available to execute tasks
     // via this->workerp(index)->addTask(...)
-    VlThreadPool(VerilatedContext* contextp, unsigned nThreads);
+    // With 'shared', the threads come from a process-wide set shared with other
+    // contexts, see VerilatedContext::threadsShared.
+    VlThreadPool(VerilatedContext* contextp, unsigned nThreads, bool shared = false);
     ~VlThreadPool() override;
 
     // METHODS
     int numThreads() const { return m_workers.size(); }
+    // All threads are pinned to CPUs, per VerilatedContext::threadsAffinity. For
+    // shared pools only the workers, as the evaluating threads are left alone.
+    bool pinned() const;
+    bool shared() const { return m_shared; }
     VlWorkerThread* workerp(int index) {
         assert(index >= 0);
         assert(static_cast<size_t>(index) < m_workers.size());
         return m_workers[index];
     }
 
+    // Static MTask execution. Queue a thread function on worker 'index'. All
+    // tasks of one evaluation must be added under a single DispatchGuard.
+    void addTask(int index, VlExecFnp fnp, VlSelfP selfp, bool evenCycle) {
+        workerp(index)->addTask(fnp, selfp, evenCycle, m_shared ? m_contextp : nullptr);
+    }
+    // Held while queueing the thread functions of one evaluation. Thread
+    // functions wait on MTasks of other threads, so with shared workers, two
+    // contexts' evaluations must be queued in the same order on every worker,
+    // otherwise each could wait behind the other. Not shared costs nothing.
+    class DispatchGuard final {
+        std::unique_lock<VerilatedMutex> m_lock;
+
+    public:
+        explicit DispatchGuard(VlThreadPool& pool)
+            : m_lock{s_dispatchMutex, std::defer_lock} {
+            if (pool.m_shared) m_lock.lock();
+        }
+    };
+
+    // Dynamic (--threads-schedule dynamic) MTask execution.
+    // Push an MTask whose upstream dependencies are all done. From within an
+    // executing MTask, this goes to the current thread's deque.
+    void pushReady(VlExecFnp fnp, VlSelfP selfp, bool evenCycle) {
+        VlWorkStealingDeque* dequep = t_dequep;
+        if (!dequep) {
+            dequep = m_deques[m_nextRootDeque.fetch_add(1, std::memory_order_relaxed)
+                              % m_deques.size()];
+        }
+        dequep->push(fnp, selfp, evenCycle);
+    }
+    // Execute ready MTasks on the calling thread and all workers, stealing
+    // from each other, until 'finalr' has all its upstream dependencies done.
+    void executeDynamic(const VlMTaskVertex& finalr, bool evenCycle);
+
+    // Pin the calling thread to the given CPU, returns false if not possible
+    static bool pinThread(int cpu);
+
 private:
+    // CPUs for threads 0 (the creating thread) to nThreads, per 'affinity'
+    static std::vector<int> affinityCpus(const std::string& affinity, unsigned nThreads);
+    // Return 'nThreads' distinct workers from the process-wide shared set
+    static std::vector<VlWorkerThread*> sharedWorkers(VerilatedContext* contextp,
+                                                      unsigned nThreads);
+    void runDynamic(DynamicExec& exec, size_t index);
+    static void dynamicHelper(VlSelfP execp, bool);
     VL_UNCOPYABLE(VlThreadPool);
 };
 
@@ -22,6 +22,8 @@
 
 #include "verilated_timing.h"
 
+#include "verilated_threads.h"
+
 //======================================================================
 // VlCoroutineHandle:: Methods
 
@@ -60,38 +62,154 @@ void VlDelayScheduler::VlDelayedCoroutine::dump() const {
 }
 #endif
 
+VlDelayScheduler::VlDelayScheduler(VerilatedContext& context, size_t wheelSlots)
+    : m_context{context} {
+    if (wheelSlots) {
+        if (VL_UNCOVERABLE(wheelSlots < 64 || (wheelSlots & (wheelSlots - 1)))) {
+            VL_FATAL_MT(__FILE__, __LINE__, "",  // LCOV_EXCL_LINE
+                        "Timing wheel size must be a power of two and at least 64");
+        }
+        m_wheel.resize(wheelSlots);
+        m_wheelOccupied.resize(wheelSlots / 64);
+    }
+}
+
+uint64_t VlDelayScheduler::wheelEarliest() const {
+    if (!m_wheelCount) return UINT64_MAX;
+    // All coroutines in the wheel are within [m_wheelTime, m_wheelTime + size), so scan the
+    // occupancy bitmap from m_wheelTime's slot, wrapping around once
+    const size_t size = m_wheel.size();
+    const size_t start = m_wheelTime & (size - 1);
+    for (size_t offset = 0; offset < size;) {
+        const size_t slot = (start + offset) & (size - 1);
+        const uint64_t bits = m_wheelOccupied[slot / 64] >> (slot % 64);
+        if (bits) {
+            size_t bit = 0;
+            while (!((bits >> bit) & 1)) ++bit;
+            return m_wheelTime + offset + bit;
+        }
+        offset += 64 - slot % 64;
+    }
+    return UINT64_MAX;  // LCOV_EXCL_LINE
+}
+
 void VlDelayScheduler::resume() {
 #ifdef VL_DEBUG
     VL_DEBUG_IF(dump(); VL_DBG_MSGF("         Resuming delayed processes\n"););
 #endif
     while (awaitingCurrentTime()) {
-        if (m_queue.front().m_timestep != m_context.time()) {
+        const uint64_t time = m_context.time();
+        if (earliest() != time) {
             VL_FATAL_MT(__FILE__, __LINE__, "",
                         "%Error: Encountered process that should've been resumed at an "
                         "earlier simulation time. Missed a time slot?");
         }
-        // Move max element in the heap to the end
-        std::pop_heap(m_queue.begin(), m_queue.end());
-        VlCoroutineHandle handle = std::move(m_queue.back().m_handle);
-        m_queue.pop_back();
-        handle.resume();
+        m_wheelTime = time;  // Nothing is left in the wheel before the current time
+        if (m_wheelNext == time) {
+            // Take the whole slot; coroutines delayed by #0 while resuming it land in the same
+            // slot again and get resumed in the next iteration
+            const size_t slot = time & (m_wheel.size() - 1);
+            std::swap(m_wheel[slot], m_resumeQueue);
+            m_wheelOccupied[slot / 64] &= ~(1ULL << (slot % 64));
+            m_wheelCount -= m_resumeQueue.size();
+            m_wheelNext = wheelEarliest();
+            for (VlCoroutineHandle& handle : m_resumeQueue) handle.resume();
+            m_resumeQueue.clear();
+            continue;
+        }
+        if (!m_queue.empty() && m_queue.front().m_timestep == time) {
+            // Move max element in the heap to the end
+            std::pop_heap(m_queue.begin(), m_queue.end());
+            VlCoroutineHandle handle = std::move(m_queue.back().m_handle);
+            m_queue.pop_back();
+            handle.resume();
+            continue;
+        }
+        resumeParallel(time);
     }
 }
 
+// State of one parallel resumption in VlDelayScheduler::resumeParallel
+struct VlParallelResume final {
+    std::vector<VlCoroutineHandle>& m_handles;  // Coroutines to resume
+    std::atomic<size_t> m_next{0};  // Index of the next coroutine to resume
+    std::atomic<int> m_pendingHelpers;  // Workers still referencing this structure
+
+    VlParallelResume(std::vector<VlCoroutineHandle>& handles, int helpers)
+        : m_handles{handles}
+        , m_pendingHelpers{helpers} {}
+    void run() {
+        for (size_t i = m_next.fetch_add(1, std::memory_order_relaxed); i < m_handles.size();
+             i = m_next.fetch_add(1, std::memory_order_relaxed)) {
+            m_handles[i].resume();
+        }
+    }
+    static void helper(VlSelfP selfp, bool) {
+        VlParallelResume& exec = *static_cast<VlParallelResume*>(selfp);
+        exec.run();
+        exec.m_pendingHelpers.fetch_sub(1, std::memory_order_release);
+    }
+};
+
+void VlDelayScheduler::resumeParallel(uint64_t time) {
+    while (!m_parallelQueue.empty() && m_parallelQueue.front().m_timestep == time) {
+        std::pop_heap(m_parallelQueue.begin(), m_parallelQueue.end());
+        m_parallelBatch.push_back(std::move(m_parallelQueue.back().m_handle));
+        m_parallelQueue.pop_back();
+    }
+    VlThreadPool* const threadPoolp = static_cast<VlThreadPool*>(m_context.threadPoolp());
+    if (!threadPoolp || m_parallelBatch.size() < 2) {
+        for (VlCoroutineHandle& handle : m_parallelBatch) handle.resume();
+    } else {
+        // The calling thread resumes coroutines too, so only ask for as many helpers as useful
+        const int helpers = static_cast<int>(std::min<size_t>(
+            threadPoolp->numThreads(), m_parallelBatch.size() - 1));
+        VlParallelResume exec{m_parallelBatch, helpers};
+        m_resumingParallel = true;
+        {
+            // Queue in the same order as the other contexts sharing the workers
+            const VlThreadPool::DispatchGuard guard{*threadPoolp};
+            for (int i = 0; i < helpers; ++i) {
+                threadPoolp->addTask(i, VlParallelResume::helper, &exec, false);
+            }
+        }
+        exec.run();
+        // 'exec' lives on our stack, so wait until no helper can still look at it
+        unsigned ct = 0;
+        while (exec.m_pendingHelpers.load(std::memory_order_acquire)) {
+            VL_CPU_RELAX();
+            if (VL_UNLIKELY(++ct > VL_LOCK_SPINS)) {
+                ct = 0;
+                VlMTaskVertex::yieldThread();
+            }
+        }
+        m_resumingParallel = false;
+    }
+    m_parallelBatch.clear();
+}
+
 uint64_t VlDelayScheduler::nextTimeSlot() const {
     if (empty()) {
         VL_FATAL_MT(__FILE__, __LINE__, "", "%Error: There is no next time slot scheduled");
     }
-    return m_queue.front().m_timestep;
+    return earliest();
 }
 
 #ifdef VL_DEBUG
 void VlDelayScheduler::dump() const {
-    if (m_queue.empty()) {
+    if (empty()) {
         VL_DBG_MSGF("         No delayed processes:\n");
     } else {
         VL_DBG_MSGF("         Delayed processes:\n");
+        for (size_t offset = 0; offset < m_wheel.size(); ++offset) {
+            const uint64_t timestep = m_wheelTime + offset;
+            for (const auto& handle : m_wheel[timestep & (m_wheel.size() - 1)]) {
+                VL_DBG_MSGF("             Awaiting time %" PRIu64 ": ", timestep);
+                handle.dump();
+            }
+        }
         for (const auto& susp : m_queue) susp.dump();
+        for (const auto& susp : m_parallelQueue) susp.dump();
     }
 }
 #endif
@@ -122,6 +240,11 @@ void VlTriggerScheduler::commit(const char* eventDescription) {
             });
     }
 #endif
+    if (m_ready.empty()) {
+        // Common case, just take the whole vector
+        std::swap(m_ready, m_uncommitted);
+        return;
+    }
     m_ready.reserve(m_ready.size() + m_uncommitted.size());
     m_ready.insert(m_ready.end(), std::make_move_iterator(m_uncommitted.begin()),
                    std::make_move_iterator(m_uncommitted.end()));
@@ -154,6 +277,13 @@ void VlTriggerScheduler::dump(const char* eventDescription) const {
 
 bool VlDynamicTriggerScheduler::evaluate() {
     VL_DEBUG_IF(dump(););
+    for (size_t group = 0; group < m_groupSuspended.size(); ++group) {
+        if (!m_groupDirty[group].exchange(false, std::memory_order_relaxed)) continue;
+        VlCoroutineVec& queue = m_groupSuspended[group];
+        m_suspended.insert(m_suspended.end(), std::make_move_iterator(queue.begin()),
+                           std::make_move_iterator(queue.end()));
+        queue.clear();
+    }
     std::swap(m_suspended, m_evaluated);
     for (auto& coro : m_evaluated) coro.resume();
     m_evaluated.clear();
@@ -194,6 +324,14 @@ void VlDynamicTriggerScheduler::dump() const {
             susp.dump();
         }
     }
+    for (size_t group = 0; group < m_groupSuspended.size(); ++group) {
+        for (const auto& susp : m_groupSuspended[group]) {
+            VL_DBG_MSGF("         Suspended processes waiting for writes to group %zu:\n",
+                        group);
+            VL_DBG_MSGF("           - ");
+            susp.dump();
+        }
+    }
 }
 #endif
 
@@ -206,6 +344,51 @@ void VlForkSync::done(const char* filename, int lineno) {
     if (m_join->m_counter == 0) m_join->m_susp.resume();
 }
 
+//======================================================================
+// VlCoroutineFramePool:: Methods
+
+thread_local VlCoroutineFramePool::ThreadCache VlCoroutineFramePool::t_cache;
+thread_local bool VlCoroutineFramePool::t_exited = false;
+std::atomic<size_t> VlCoroutineFramePool::s_maxFree{1024};
+VerilatedMutex VlCoroutineFramePool::s_mutex;
+std::set<const VlCoroutineFramePool::ThreadCounts*> VlCoroutineFramePool::s_countps;
+VlCoroutineFrameCounts VlCoroutineFramePool::s_exitedCounts;
+
+VlCoroutineFramePool::ThreadCache::ThreadCache() {
+    const VerilatedLockGuard lock{s_mutex};
+    s_countps.insert(&m_counts);
+}
+
+VlCoroutineFramePool::ThreadCache::~ThreadCache() {
+    // Frames freed after this point (e.g. by destroying a model at exit) bypass the pool
+    t_exited = true;
+    for (FreeFrame* framep : m_freeps) {
+        while (framep) {
+            FreeFrame* const nextp = framep->m_nextp;
+            ::operator delete(framep);
+            framep = nextp;
+        }
+    }
+    const VerilatedLockGuard lock{s_mutex};
+    s_countps.erase(&m_counts);
+    const VlCoroutineFrameCounts counts = m_counts.load();
+    s_exitedCounts.m_allocs += counts.m_allocs;
+    s_exitedCounts.m_reuses += counts.m_reuses;
+    s_exitedCounts.m_bytes += counts.m_bytes;
+}
+
+VlCoroutineFrameCounts VlCoroutineFramePool::counts() VL_MT_SAFE_EXCLUDES(s_mutex) {
+    const VerilatedLockGuard lock{s_mutex};
+    VlCoroutineFrameCounts total = s_exitedCounts;
+    for (const ThreadCounts* const countsp : s_countps) {
+        const VlCoroutineFrameCounts counts = countsp->load();
+        total.m_allocs += counts.m_allocs;
+        total.m_reuses += counts.m_reuses;
+        total.m_bytes += counts.m_bytes;
+    }
+    return total;
+}
+
 //======================================================================
 // VlCoroutine:: Methods
 
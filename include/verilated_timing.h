@@ -26,6 +26,7 @@
 #define VERILATOR_VERILATED_TIMING_H_
 
 #include "verilated.h"
+#include "verilated_profiler.h"
 
 // clang-format off
 // Some preprocessor magic to support both Clang and GCC coroutines with both libc++ and libstdc++
@@ -145,6 +146,17 @@ public:
 //=============================================================================
 // VlDelayScheduler stores coroutines to be resumed at a certain simulation time. If the current
 // time is equal to a coroutine's resume time, the coroutine gets resumed.
+//
+// By default the coroutines are kept in a heap. Optionally (see --timing-wheel) delays that end
+// within a fixed horizon from the current time are instead kept in a timing wheel: a circular
+// array of slots, one per time step, which makes scheduling and resuming such a delay O(1).
+// Delays beyond the horizon still go to the heap. Coroutines in the same wheel slot are resumed
+// in the order they were suspended.
+//
+// Coroutines suspended by delayParallel() (see -ftiming-parallel) are kept in a separate heap.
+// Verilator only uses it in processes it proved not to access any variable written by another
+// such process, so when several of them are due at the same time, they are resumed concurrently
+// on the worker threads of the context's thread pool.
 
 class VlDelayScheduler final {
     // TYPES
@@ -161,15 +173,68 @@ class VlDelayScheduler final {
 #endif
     };
     using VlDelayedCoroutineQueue = std::vector<VlDelayedCoroutine>;
+    using VlCoroutineVec = std::vector<VlCoroutineHandle>;
 
     // MEMBERS
     VerilatedContext& m_context;
     VlDelayedCoroutineQueue m_queue;  // Coroutines to be restored at a certain simulation time
+    std::vector<VlCoroutineVec> m_wheel;  // Timing wheel slots, indexed by timestep modulo size;
+                                          // empty if the wheel is disabled
+    std::vector<uint64_t> m_wheelOccupied;  // Bitmap of non-empty wheel slots
+    VlCoroutineVec m_resumeQueue;  // Wheel slot being resumed by resume(); kept as a field to
+                                   // avoid reallocation
+    uint64_t m_wheelTime = 0;  // Earliest timestep the wheel can hold (its horizon starts here)
+    uint64_t m_wheelNext = UINT64_MAX;  // Earliest timestep in the wheel, UINT64_MAX if none
+    size_t m_wheelCount = 0;  // Number of coroutines in the wheel
+    VlDelayedCoroutineQueue m_parallelQueue;  // Coroutines that may be resumed in parallel
+    VlCoroutineVec m_parallelBatch;  // Coroutines being resumed by resumeParallel()
+    VerilatedMutex m_parallelMutex;  // Guards m_parallelQueue while resuming in parallel
+    bool m_resumingParallel = false;  // Inside resumeParallel(), on multiple threads
+
+    // METHODS
+    // Earliest timestep in the wheel at or after m_wheelTime, UINT64_MAX if none
+    uint64_t wheelEarliest() const;
+    // Earliest timestep of all delayed coroutines, UINT64_MAX if none
+    uint64_t earliest() const {
+        uint64_t result = m_wheelNext;
+        if (!m_queue.empty()) result = std::min(result, m_queue.front().m_timestep);
+        if (!m_parallelQueue.empty()) {
+            result = std::min(result, m_parallelQueue.front().m_timestep);
+        }
+        return result;
+    }
+    // Schedule a coroutine for resumption at the given simulation time
+    void push(uint64_t timestep, VlCoroutineHandle&& handle) {
+        // Rebase the wheel on the current time if possible, to extend its horizon
+        if (!m_wheelCount) m_wheelTime = m_context.time();
+        if (timestep - m_wheelTime < m_wheel.size()) {  // Always false if the wheel is disabled
+            const size_t slot = timestep & (m_wheel.size() - 1);
+            m_wheel[slot].push_back(std::move(handle));
+            m_wheelOccupied[slot / 64] |= 1ULL << (slot % 64);
+            ++m_wheelCount;
+            if (timestep < m_wheelNext) m_wheelNext = timestep;
+        } else {
+            m_queue.push_back({timestep, std::move(handle)});
+            // Move last element to the proper place in the max-heap
+            std::push_heap(m_queue.begin(), m_queue.end());
+        }
+    }
+    // Schedule a coroutine that may be resumed in parallel with others
+    void pushParallel(uint64_t timestep, VlCoroutineHandle&& handle) {
+        // Workers resuming other coroutines of the batch may push concurrently
+        std::unique_lock<VerilatedMutex> lock{m_parallelMutex, std::defer_lock};
+        if (VL_UNLIKELY(m_resumingParallel)) lock.lock();
+        m_parallelQueue.push_back({timestep, std::move(handle)});
+        std::push_heap(m_parallelQueue.begin(), m_parallelQueue.end());
+    }
+    // Resume all coroutines in m_parallelQueue waiting for the given time
+    void resumeParallel(uint64_t time);
 
 public:
     // CONSTRUCTORS
-    explicit VlDelayScheduler(VerilatedContext& context)
-        : m_context{context} {}
+    // 'wheelSlots' is the number of timing wheel slots; zero disables the wheel, otherwise it
+    // must be a power of two and at least 64
+    explicit VlDelayScheduler(VerilatedContext& context, size_t wheelSlots = 0);
     // METHODS
     // Resume coroutines waiting for the current simulation time
     void resume();
@@ -177,11 +242,9 @@ public:
     // coroutines)
     uint64_t nextTimeSlot() const;
     // Are there no delayed coroutines awaiting?
-    bool empty() const { return m_queue.empty(); }
+    bool empty() const { return m_queue.empty() && !m_wheelCount && m_parallelQueue.empty(); }
     // Are there coroutines to resume at the current simulation time?
-    bool awaitingCurrentTime() const {
-        return !empty() && m_queue.front().m_timestep <= m_context.time();
-    }
+    bool awaitingCurrentTime() const { return earliest() <= m_context.time(); }
 #ifdef VL_DEBUG
     void dump() const;
 #endif
@@ -190,19 +253,36 @@ public:
                int lineno = 0) {
         struct Awaitable {
             VlProcessRef process;  // Data of the suspended process, null if not needed
-            VlDelayedCoroutineQueue& queue;
+            VlDelayScheduler& scheduler;
+            uint64_t delay;
+            VlFileLineDebug fileline;
+
+            bool await_ready() const { return false; }  // Always suspend
+            void await_suspend(std::coroutine_handle<> coro) {
+                scheduler.push(delay, VlCoroutineHandle{coro, process, fileline});
+            }
+            void await_resume() const {}
+        };
+        return Awaitable{process, *this, m_context.time() + delay,
+                         VlFileLineDebug{filename, lineno}};
+    }
+    // Same as delay(), for processes whose resumption may run in parallel with other such
+    // processes due at the same time
+    auto delayParallel(uint64_t delay, VlProcessRef process, const char* filename = VL_UNKNOWN,
+                       int lineno = 0) {
+        struct Awaitable {
+            VlProcessRef process;  // Data of the suspended process, null if not needed
+            VlDelayScheduler& scheduler;
             uint64_t delay;
             VlFileLineDebug fileline;
 
             bool await_ready() const { return false; }  // Always suspend
             void await_suspend(std::coroutine_handle<> coro) {
-                queue.push_back({delay, VlCoroutineHandle{coro, process, fileline}});
-                // Move last element to the proper place in the max-heap
-                std::push_heap(queue.begin(), queue.end());
+                scheduler.pushParallel(delay, VlCoroutineHandle{coro, process, fileline});
             }
             void await_resume() const {}
         };
-        return Awaitable{process, m_queue, m_context.time() + delay,
+        return Awaitable{process, *this, m_context.time() + delay,
                          VlFileLineDebug{filename, lineno}};
     }
 };
@@ -276,6 +356,10 @@ public:
 // The coroutines get resumed at trigger evaluation time, evaluate their local triggers, optionally
 // await the post update step, and if the trigger is set, await proper resumption in the 'act' eval
 // step.
+//
+// With -ftiming-trigger-deps, triggers whose dependencies are known await dependentEvaluation()
+// instead, passing a dependency group. Code writing a variable the group depends on calls
+// written() for the group, and evaluate() only resumes the coroutines of written groups.
 
 class VlDynamicTriggerScheduler final {
     // TYPES
@@ -287,6 +371,11 @@ class VlDynamicTriggerScheduler final {
     VlCoroutineVec m_triggered;  // Coroutines whose triggers were set, and are awaiting resumption
     VlCoroutineVec m_post;  // Coroutines awaiting the post update step (only relevant for triggers
                             // with destructive post updates, e.g. named events)
+    std::vector<VlCoroutineVec> m_groupSuspended;  // Suspended coroutines awaiting trigger
+                                                   // evaluation, by dependency group
+    // Dependency groups written since the last evaluation. Set concurrently by written(), only
+    // grown by dependentEvaluation(), which is never concurrent with written().
+    std::deque<std::atomic<bool>> m_groupDirty;
 
     // METHODS
     auto awaitable(VlProcessRef process, VlCoroutineVec& queue, const char* filename, int lineno) {
@@ -307,6 +396,11 @@ class VlDynamicTriggerScheduler final {
 public:
     // Evaluates all dynamic triggers (resumed coroutines that co_await evaluation())
     bool evaluate();
+    // Marks the given dependency group dirty, so that the triggers awaiting
+    // dependentEvaluation() for it are evaluated by the next evaluate()
+    void written(uint32_t group) {
+        if (group < m_groupDirty.size()) m_groupDirty[group].store(true, std::memory_order_relaxed);
+    }
     // Runs post updates for all dynamic triggers (resumes coroutines that co_await postUpdate())
     void doPostUpdates();
     // Resumes all coroutines whose triggers are set (those that co_await resumption())
@@ -321,6 +415,19 @@ public:
                                 eventDescription, filename, lineno););
         return awaitable(process, m_suspended, filename, lineno);
     }
+    // Used by coroutines for co_awaiting trigger evaluation after a variable of the given
+    // dependency group is written
+    auto dependentEvaluation(VlProcessRef process, uint32_t group,
+                             const char* eventDescription = VL_UNKNOWN,
+                             const char* filename = VL_UNKNOWN, int lineno = 0) {
+        VL_DEBUG_IF(VL_DBG_MSGF("         Suspending process waiting for %s at %s:%d\n",
+                                eventDescription, filename, lineno););
+        if (VL_UNLIKELY(group >= m_groupSuspended.size())) {
+            m_groupSuspended.resize(group + 1);
+            while (m_groupDirty.size() <= group) m_groupDirty.emplace_back(false);
+        }
+        return awaitable(process, m_groupSuspended[group], filename, lineno);
+    }
     // Used by coroutines for co_awaiting the trigger post update step
     auto postUpdate(VlProcessRef process, const char* eventDescription, const char* filename,
                     int lineno) {
@@ -388,6 +495,102 @@ public:
     }
 };
 
+//=============================================================================
+// VlCoroutineFramePool allocates coroutine frames. Frame sizes are rounded up to size classes,
+// and freed frames are kept in per-thread free lists, so that the frames of finished processes
+// get reused by new ones instead of going through the global allocator for every delay, event
+// wait or fork. Frames larger than the largest size class are not pooled.
+
+class VlCoroutineFramePool final {
+    // CONSTANTS
+    static constexpr size_t GRANULE = 64;  // Size class granularity in bytes
+    static constexpr size_t CLASSES = 16;  // Number of size classes, largest is 1 KiB
+
+    // TYPES
+    struct FreeFrame final {
+        FreeFrame* m_nextp;  // Next frame in the free list
+    };
+    // Allocation counts of a thread. Only written by the owning thread, but read by counts()
+    // from any thread, so atomic. Relaxed, as the sum is only a statistic
+    struct ThreadCounts final {
+        std::atomic<uint64_t> m_allocs{0};  // Number of frames allocated
+        std::atomic<uint64_t> m_reuses{0};  // Number of frames allocated by reusing a freed frame
+        std::atomic<uint64_t> m_bytes{0};  // Total size of frames allocated
+        static void add(std::atomic<uint64_t>& counter, uint64_t value) {
+            // Single writer, so no need for an atomic read-modify-write
+            counter.store(counter.load(std::memory_order_relaxed) + value,
+                          std::memory_order_relaxed);
+        }
+        VlCoroutineFrameCounts load() const {
+            VlCoroutineFrameCounts counts;
+            counts.m_allocs = m_allocs.load(std::memory_order_relaxed);
+            counts.m_reuses = m_reuses.load(std::memory_order_relaxed);
+            counts.m_bytes = m_bytes.load(std::memory_order_relaxed);
+            return counts;
+        }
+    };
+    // Free lists of a thread, and the allocation counts of the thread. Registered on
+    // construction, so the counts can be summed over all threads
+    struct ThreadCache final {
+        std::array<FreeFrame*, CLASSES> m_freeps{};  // Free list heads, by size class
+        std::array<size_t, CLASSES> m_freeSizes{};  // Free list lengths, by size class
+        ThreadCounts m_counts;  // Allocation counts of this thread
+        ThreadCache();
+        ~ThreadCache();
+    };
+
+    // MEMBERS
+    static thread_local ThreadCache t_cache;  // Free lists of the current thread
+    static thread_local bool t_exited;  // The current thread's ThreadCache was destroyed
+    static std::atomic<size_t> s_maxFree;  // Maximum length of a free list, 0 disables reuse
+    static VerilatedMutex s_mutex;  // Protects the members below
+    // Allocation counts of threads with a live ThreadCache
+    static std::set<const ThreadCounts*> s_countps VL_GUARDED_BY(s_mutex);
+    // Allocation counts of exited threads, summed
+    static VlCoroutineFrameCounts s_exitedCounts VL_GUARDED_BY(s_mutex);
+
+public:
+    // METHODS
+    // Allocate a frame of the given size
+    static void* allocate(size_t size) {
+        const size_t sizeClass = (size - 1) / GRANULE;
+        if (VL_UNLIKELY(sizeClass >= CLASSES || t_exited)) return ::operator new(size);
+        ThreadCache& cache = t_cache;
+        ThreadCounts::add(cache.m_counts.m_allocs, 1);
+        ThreadCounts::add(cache.m_counts.m_bytes, size);
+        if (FreeFrame* const framep = cache.m_freeps[sizeClass]) {
+            cache.m_freeps[sizeClass] = framep->m_nextp;
+            --cache.m_freeSizes[sizeClass];
+            ThreadCounts::add(cache.m_counts.m_reuses, 1);
+            return framep;
+        }
+        return ::operator new((sizeClass + 1) * GRANULE);
+    }
+    // Free a frame of the given size, keeping it for reuse if the free list is not full
+    static void deallocate(void* ptr, size_t size) noexcept {
+        const size_t sizeClass = (size - 1) / GRANULE;
+        if (VL_UNLIKELY(sizeClass >= CLASSES || t_exited)) {
+            ::operator delete(ptr);
+            return;
+        }
+        ThreadCache& cache = t_cache;
+        const size_t maxFree = s_maxFree.load(std::memory_order_relaxed);
+        if (VL_UNLIKELY(cache.m_freeSizes[sizeClass] >= maxFree)) {
+            ::operator delete(ptr);
+            return;
+        }
+        FreeFrame* const framep = static_cast<FreeFrame*>(ptr);
+        framep->m_nextp = cache.m_freeps[sizeClass];
+        cache.m_freeps[sizeClass] = framep;
+        ++cache.m_freeSizes[sizeClass];
+    }
+    // Set the maximum number of freed frames kept per thread and size class; 0 disables reuse
+    static void maxFree(size_t value) { s_maxFree.store(value, std::memory_order_relaxed); }
+    // Allocation counts summed over all threads, for VlExecutionProfiler::frameCountsCb.
+    // May be called while other threads allocate frames
+    static VlCoroutineFrameCounts counts() VL_MT_SAFE_EXCLUDES(s_mutex);
+};
+
 //=============================================================================
 // VlCoroutine
 // Return value of a coroutine. Used for chaining coroutine suspension/resumption.
@@ -401,6 +604,12 @@ private:
 
         ~VlPromise();
 
+        // Allocate coroutine frames from the frame pool
+        static void* operator new(size_t size) { return VlCoroutineFramePool::allocate(size); }
+        static void operator delete(void* ptr, size_t size) noexcept {
+            VlCoroutineFramePool::deallocate(ptr, size);
+        }
+
         VlCoroutine get_return_object() { return {this}; }
 
         // Never suspend at the start of the coroutine
@@ -243,9 +243,35 @@ private:
 
     // Flush any remaining data for this file
     static void onFlush(void* selfp) VL_MT_UNSAFE_ONE;
+    // Write the flight recorded changes to this file
+    static void onDumpFlush(void* selfp) VL_MT_UNSAFE_ONE;
     // Close the file on termination
     static void onExit(void* selfp) VL_MT_UNSAFE_ONE;
 
+    // Flight recording: keep the most recent changes in memory, and only write them
+    // on $dumpflush, $stop, $fatal or an explicit flightFlush()
+    struct FlightDump final {
+        uint64_t m_time;  // Time point of the dump
+        std::vector<uint32_t> m_cmds;  // Changes, as VerilatedTraceOffloadCommand records
+    };
+    bool m_flight = false;  // Record changes in memory instead of writing them
+    size_t m_flightMaxDumps = 0;  // Number of most recent dumps to keep (0 = no limit)
+    size_t m_flightMaxBytes = 0;  // Memory limit for the recorded dumps (0 = no limit)
+    size_t m_flightBytes = 0;  // Memory used by m_flightDumps
+    std::deque<FlightDump> m_flightDumps;  // Recorded dumps, oldest first
+    std::vector<uint32_t> m_flightBase;  // Values before the oldest recorded dump
+    std::vector<uint32_t> m_flightBaseIndex;  // Code -> position of the value in m_flightBase
+    std::vector<std::vector<uint32_t>> m_flightFree;  // Storage of retired dumps for reuse
+    std::vector<std::vector<uint32_t>> m_flightScratch;  // Per callback changes when parallel
+    std::vector<uint32_t>* m_flightRecordp = nullptr;  // Changes of the dump in progress
+
+    // Start recording a dump at the given time point
+    void flightStart(uint64_t timeui);
+    // Finish recording the dump in progress, and forget dumps beyond the limits
+    void flightFinish();
+    // Fold the oldest recorded dump into the base values
+    void flightRetire();
+
     // Number of total offload buffers that have been allocated
     uint32_t m_numOffloadBuffers = 0;
     // Size of offload buffers
@@ -309,6 +335,8 @@ protected:
 
     void closeBase();
     void flushBase();
+    // Write the recorded changes, if flight recording
+    void flightWrite();
 
     bool offload() const { return m_offload; }
     bool parallel() const { return m_parallel; }
@@ -348,6 +376,10 @@ public:
     // If level = 0, dump everything and hier is then ignored
     void dumpvars(int level, const std::string& hier) VL_MT_SAFE;
 
+    // Record changes in memory, keeping the last 'maxDumps' dumps and using up
+    // to about 'maxBytes' (0 = no limit), and only write them on flightFlush
+    void flightRecorder(size_t maxDumps, size_t maxBytes) VL_MT_SAFE_EXCLUDES(m_mutex);
+
     // Call
     void dump(uint64_t timeui) VL_MT_SAFE_EXCLUDES(m_mutex);
 
@@ -387,10 +419,19 @@ protected:
     static_assert(std::is_base_of<VerilatedTrace<Trace, T_Buffer>, Trace>::value, "");
 
     friend Trace;  // Give the trace file access to the private bits
+    friend VerilatedTrace<Trace, T_Buffer>;
     friend std::default_delete<VerilatedTraceBuffer<T_Buffer>>;
 
     uint32_t* const m_sigs_oldvalp;  // Previous value store
-    EData* const m_sigs_enabledp;  // Bit vector of enabled codes (nullptr = all on)
+    // Bit vector of enabled codes (nullptr = all on, never nullptr when flight recording)
+    EData* const m_sigs_enabledp;
+    // Where to record changes when flight recording, instead of emitting them
+    std::vector<uint32_t>* m_flightp = nullptr;
+
+    // Record a change when flight recording. The value is 'words' words at 'valuep'
+    void flightRecord(uint32_t cmd, uint32_t code, const uint32_t* valuep, int words);
+    // Emit the recorded changes between 'readp' and 'endp'
+    void flightReplay(const uint32_t* readp, const uint32_t* endp);
 
     explicit VerilatedTraceBuffer(Trace& owner);
     ~VerilatedTraceBuffer() override = default;
@@ -466,6 +507,14 @@ public:
         std::memcpy(&old, oldp, sizeof(old));
         if (VL_UNLIKELY(old != newval)) fullDouble(oldp, newval);
     }
+
+    // Check previous dumped values of 'count' signals with consecutive codes, held in
+    // consecutive array elements. Compares blocks of elements at a time, and emits trace
+    // entries for those that changed.
+    void chgBitArray(uint32_t* oldp, const CData* newvalp, int count);
+    void chgCDataArray(uint32_t* oldp, const CData* newvalp, int count, int bits);
+    void chgSDataArray(uint32_t* oldp, const SData* newvalp, int count, int bits);
+    void chgIDataArray(uint32_t* oldp, const IData* newvalp, int count, int bits);
 };
 
 //=============================================================================
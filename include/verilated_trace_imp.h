@@ -278,6 +278,92 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::flushBase() {
     }
 }
 
+//=============================================================================
+// Flight recording
+
+// Number of words in a recorded change
+static inline size_t flightCmdWords(uint32_t cmd) {
+    switch (cmd & 0xF) {
+    case VerilatedTraceOffloadCommand::CHG_CDATA:
+    case VerilatedTraceOffloadCommand::CHG_SDATA:
+    case VerilatedTraceOffloadCommand::CHG_IDATA: return 3;
+    case VerilatedTraceOffloadCommand::CHG_QDATA:
+    case VerilatedTraceOffloadCommand::CHG_DOUBLE: return 4;
+    case VerilatedTraceOffloadCommand::CHG_WDATA: return 2 + VL_WORDS_I(cmd >> 4);
+    default: return 2;  // Bits and events
+    }
+}
+
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::flightStart(uint64_t timeui) {
+    std::vector<uint32_t> cmds;
+    if (!m_flightFree.empty()) {
+        cmds = std::move(m_flightFree.back());
+        m_flightFree.pop_back();
+    }
+    m_flightDumps.push_back(FlightDump{timeui, std::move(cmds)});
+    m_flightRecordp = &m_flightDumps.back().m_cmds;
+}
+
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::flightRetire() {
+    FlightDump& item = m_flightDumps.front();
+    const std::vector<uint32_t>& cmds = item.m_cmds;
+    for (size_t i = 0; i < cmds.size();) {
+        const uint32_t cmd = cmds[i];
+        const size_t words = flightCmdWords(cmd);
+        // Events have no value to keep
+        if ((cmd & 0xF) != VerilatedTraceOffloadCommand::CHG_EVENT) {
+            uint32_t& pos = m_flightBaseIndex[cmds[i + 1]];
+            if (pos == UINT32_MAX) {
+                pos = static_cast<uint32_t>(m_flightBase.size());
+                m_flightBase.insert(m_flightBase.end(), &cmds[i], &cmds[i] + words);
+            } else {
+                std::copy(&cmds[i], &cmds[i] + words, &m_flightBase[pos]);
+            }
+        }
+        i += words;
+    }
+    m_flightBytes -= cmds.size() * sizeof(uint32_t);
+    item.m_cmds.clear();
+    m_flightFree.push_back(std::move(item.m_cmds));
+    m_flightDumps.pop_front();
+}
+
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::flightFinish() {
+    m_flightBytes += m_flightRecordp->size() * sizeof(uint32_t);
+    m_flightRecordp = nullptr;
+    // Always keep the latest dump, even if it is over the memory limit on its own
+    while (m_flightDumps.size() > 1
+           && ((m_flightMaxDumps && m_flightDumps.size() > m_flightMaxDumps)
+               || (m_flightMaxBytes && m_flightBytes > m_flightMaxBytes))) {
+        flightRetire();
+    }
+}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::flightReplay(const uint32_t* readp, const uint32_t* endp);
+
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::flightWrite() {
+    if (m_flightDumps.empty()) return;
+    // The base values start the window, at the time of the oldest recorded dump
+    bool first = true;
+    for (const FlightDump& item : m_flightDumps) {
+        emitTimeChange(item.m_time);
+        Buffer* const bufp = getTraceBuffer();
+        if (first) {
+            bufp->flightReplay(m_flightBase.data(), m_flightBase.data() + m_flightBase.size());
+        }
+        bufp->flightReplay(item.m_cmds.data(), item.m_cmds.data() + item.m_cmds.size());
+        commitTraceBuffer(bufp);
+        first = false;
+    }
+    // What was written now only contributes to the base values of the next window
+    while (!m_flightDumps.empty()) flightRetire();
+}
+
 //=============================================================================
 // Callbacks to run on global events
 
@@ -287,6 +373,12 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::onFlush(void* selfp) {
     reinterpret_cast<VL_SUB_T*>(selfp)->flush();
 }
 
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::onDumpFlush(void* selfp) {
+    // This calls 'flightFlush' on the derived class (which must then get any mutex)
+    reinterpret_cast<VL_SUB_T*>(selfp)->flightFlush();
+}
+
 template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::onExit(void* selfp) {
     // This calls 'close' on the derived class (which must then get any mutex)
@@ -307,6 +399,7 @@ VerilatedTrace<VL_SUB_T, VL_BUF_T>::~VerilatedTrace() {
     if (m_sigs_oldvalp) VL_DO_CLEAR(delete[] m_sigs_oldvalp, m_sigs_oldvalp = nullptr);
     if (m_sigs_enabledp) VL_DO_CLEAR(delete[] m_sigs_enabledp, m_sigs_enabledp = nullptr);
     Verilated::removeFlushCb(VerilatedTrace<VL_SUB_T, VL_BUF_T>::onFlush, this);
+    Verilated::removeDumpFlushCb(VerilatedTrace<VL_SUB_T, VL_BUF_T>::onDumpFlush, this);
     Verilated::removeExitCb(VerilatedTrace<VL_SUB_T, VL_BUF_T>::onExit, this);
     if (offload()) closeBase();
 }
@@ -359,6 +452,25 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::traceInit() VL_MT_UNSAFE {
         m_sigs_enabledVec.clear();
     }
 
+    if (m_flight) {
+        if (VL_UNCOVERABLE(offload())) {
+            VL_FATAL_MT(__FILE__, __LINE__, "",
+                        "Flight recording is not supported with offloaded tracing");
+        }
+        m_flightBytes = 0;
+        while (!m_flightDumps.empty()) flightRetire();
+        m_flightBase.clear();
+        m_flightBaseIndex.assign(nextCode(), UINT32_MAX);
+        // The buffers only check for recording when there are enables, so enable all
+        if (!m_sigs_enabledp) {
+            const size_t words = 1 + VL_WORDS_I(nextCode());
+            m_sigs_enabledp = new uint32_t[words];
+            std::memset(m_sigs_enabledp, 0xff, words * sizeof(uint32_t));
+        }
+        // Set callback so $dumpflush/$stop/$fatal will write the recorded changes
+        Verilated::addDumpFlushCb(VerilatedTrace<VL_SUB_T, VL_BUF_T>::onDumpFlush, this);
+    }
+
     // Set callback so flush/abort will flush this file
     Verilated::addFlushCb(VerilatedTrace<VL_SUB_T, VL_BUF_T>::onFlush, this);
     Verilated::addExitCb(VerilatedTrace<VL_SUB_T, VL_BUF_T>::onExit, this);
@@ -461,6 +573,23 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dumpvars(int level, const std::string&
     }
 }
 
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::flightRecorder(size_t maxDumps, size_t maxBytes)
+    VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    if (VL_UNCOVERABLE(m_didSomeDump)) {  // LCOV_EXCL_START
+        VL_FATAL_MT(__FILE__, __LINE__, "",
+                    "Cannot start flight recording if 'dump' has already been called");
+    }  // LCOV_EXCL_STOP
+    if (VL_UNCOVERABLE(m_sigs_oldvalp)) {  // LCOV_EXCL_START
+        VL_FATAL_MT(__FILE__, __LINE__, "",
+                    "Cannot start flight recording if 'open' has already been called");
+    }  // LCOV_EXCL_STOP
+    m_flight = true;
+    m_flightMaxDumps = maxDumps;
+    m_flightMaxBytes = maxBytes;
+}
+
 template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::parallelWorkerTask(void* datap, bool) {
     ParallelWorkerData* const wdp = reinterpret_cast<ParallelWorkerData*>(datap);
@@ -476,10 +605,11 @@ template <>
 VL_ATTR_NOINLINE void VerilatedTrace<VL_SUB_T, VL_BUF_T>::ParallelWorkerData::wait() {
     // Spin for a while, waiting for the buffer to become ready
     for (int i = 0; i < VL_LOCK_SPINS; ++i) {
-        if (VL_LIKELY(m_ready.load(std::memory_order_relaxed))) return;
+        if (VL_LIKELY(m_ready.load(std::memory_order_relaxed))) break;
         VL_CPU_RELAX();
     }
-    // We have been spinning for a while, so yield the thread
+    // Yield the thread if still not ready. Take the lock even if ready, so the worker is done
+    // with this item (which the caller is about to destroy), and its buffer is visible.
     VerilatedLockGuard lock{m_mutex};
     m_waiting = true;
     m_cv.wait(m_mutex, [this] { return m_ready.load(std::memory_order_relaxed); });
@@ -497,11 +627,16 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runCallbacks(const std::vector<Callback
         const unsigned threads = threadPoolp->numThreads() + 1;
         // Main thread executes all jobs with index % threads == 0
         std::vector<ParallelWorkerData*> mainThreadWorkerData;
+        if (VL_UNLIKELY(m_flightRecordp && m_flightScratch.size() < cbVec.size())) {
+            m_flightScratch.resize(cbVec.size());
+        }
         // Enqueue all the jobs
         for (unsigned i = 0; i < cbVec.size(); ++i) {
             const CallbackRecord& cbr = cbVec[i];
             // Always get the trace buffer on the main thread
             Buffer* const bufp = getTraceBuffer();
+            // Each buffer records flight changes separately, gathered in order below
+            if (VL_UNLIKELY(m_flightRecordp)) bufp->m_flightp = &m_flightScratch[i];
             // Create new work item
             workerData.emplace_back(cbr.m_dumpCb, cbr.m_userp, bufp);
             // Grab the new work item
@@ -521,6 +656,11 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runCallbacks(const std::vector<Callback
         for (ParallelWorkerData& item : workerData) {
             // Wait until ready
             item.wait();
+            // Gather flight recorded changes
+            if (std::vector<uint32_t>* const cmdsp = item.m_bufp->m_flightp) {
+                m_flightRecordp->insert(m_flightRecordp->end(), cmdsp->begin(), cmdsp->end());
+                cmdsp->clear();
+            }
             // Commit the buffer
             commitTraceBuffer(item.m_bufp);
         }
@@ -531,6 +671,7 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runCallbacks(const std::vector<Callback
     // Fall back on sequential execution
     for (const CallbackRecord& cbr : cbVec) {
         Buffer* const traceBufferp = getTraceBuffer();
+        traceBufferp->m_flightp = m_flightRecordp;
         cbr.m_dumpCb(cbr.m_userp, traceBufferp);
         commitTraceBuffer(traceBufferp);
     }
@@ -589,6 +730,9 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dump(uint64_t timeui) VL_MT_SAFE_EXCLUD
             flushBase();
             emitTimeChange(timeui);
         }
+    } else if (VL_UNLIKELY(m_flight)) {
+        // Record the changes, the time point is only written on flush
+        flightStart(timeui);
     } else {
         // Update time point
         emitTimeChange(timeui);
@@ -615,6 +759,8 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dump(uint64_t timeui) VL_MT_SAFE_EXCLUD
         cbr.m_cleanupCb(cbr.m_userp, self());
     }
 
+    if (VL_UNLIKELY(m_flightRecordp)) flightFinish();
+
     if (offload() && VL_LIKELY(bufferp)) {
         // Mark end of the offload buffer we just filled
         *m_offloadBufferWritep++ = VerilatedTraceOffloadCommand::END;
@@ -825,16 +971,32 @@ VerilatedTraceBuffer<VL_BUF_T>::VerilatedTraceBuffer(Trace& owner)
     , m_sigs_oldvalp{owner.m_sigs_oldvalp}
     , m_sigs_enabledp{owner.m_sigs_enabledp} {}
 
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::flightRecord(uint32_t cmd, uint32_t code,
+                                                  const uint32_t* valuep, int words) {
+    m_flightp->push_back(cmd);
+    m_flightp->push_back(code);
+    m_flightp->insert(m_flightp->end(), valuep, valuep + words);
+}
+
 // These functions must write the new value back into the old value store,
 // and subsequently call the format specific emit* implementations. Note
 // that this file must be included in the format specific implementation, so
-// the emit* functions can be inlined for performance.
+// the emit* functions can be inlined for performance. When flight
+// recording, m_sigs_enabledp is always set, so recording is only checked on
+// that already unlikely path, and not for every signal otherwise.
 
 template <>
 void VerilatedTraceBuffer<VL_BUF_T>::fullBit(uint32_t* oldp, CData newval) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     *oldp = newval;  // Still copy even if not tracing so chg doesn't call full
-    if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_sigs_enabledp)) {
+        if (!(VL_BITISSET_W(m_sigs_enabledp, code))) return;
+        if (m_flightp) {
+            flightRecord(VerilatedTraceOffloadCommand::CHG_BIT_0 | newval, code, nullptr, 0);
+            return;
+        }
+    }
     emitBit(code, newval);
 }
 
@@ -842,6 +1004,12 @@ template <>
 void VerilatedTraceBuffer<VL_BUF_T>::fullEvent(uint32_t* oldp, VlEvent newval) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     *oldp = 1;  // Do we really store an "event" ?
+    if (VL_UNLIKELY(m_sigs_enabledp) && m_flightp) {
+        if (newval.isTriggered()) {
+            flightRecord(VerilatedTraceOffloadCommand::CHG_EVENT, code, nullptr, 0);
+        }
+        return;
+    }
     emitEvent(code, newval);
 }
 
@@ -849,7 +1017,13 @@ template <>
 void VerilatedTraceBuffer<VL_BUF_T>::fullCData(uint32_t* oldp, CData newval, int bits) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     *oldp = newval;  // Still copy even if not tracing so chg doesn't call full
-    if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_sigs_enabledp)) {
+        if (!(VL_BITISSET_W(m_sigs_enabledp, code))) return;
+        if (m_flightp) {
+            flightRecord((bits << 4) | VerilatedTraceOffloadCommand::CHG_CDATA, code, oldp, 1);
+            return;
+        }
+    }
     emitCData(code, newval, bits);
 }
 
@@ -857,7 +1031,13 @@ template <>
 void VerilatedTraceBuffer<VL_BUF_T>::fullSData(uint32_t* oldp, SData newval, int bits) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     *oldp = newval;  // Still copy even if not tracing so chg doesn't call full
-    if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_sigs_enabledp)) {
+        if (!(VL_BITISSET_W(m_sigs_enabledp, code))) return;
+        if (m_flightp) {
+            flightRecord((bits << 4) | VerilatedTraceOffloadCommand::CHG_SDATA, code, oldp, 1);
+            return;
+        }
+    }
     emitSData(code, newval, bits);
 }
 
@@ -865,7 +1045,13 @@ template <>
 void VerilatedTraceBuffer<VL_BUF_T>::fullIData(uint32_t* oldp, IData newval, int bits) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     *oldp = newval;  // Still copy even if not tracing so chg doesn't call full
-    if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_sigs_enabledp)) {
+        if (!(VL_BITISSET_W(m_sigs_enabledp, code))) return;
+        if (m_flightp) {
+            flightRecord((bits << 4) | VerilatedTraceOffloadCommand::CHG_IDATA, code, oldp, 1);
+            return;
+        }
+    }
     emitIData(code, newval, bits);
 }
 
@@ -873,7 +1059,13 @@ template <>
 void VerilatedTraceBuffer<VL_BUF_T>::fullQData(uint32_t* oldp, QData newval, int bits) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     std::memcpy(oldp, &newval, sizeof(newval));
-    if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_sigs_enabledp)) {
+        if (!(VL_BITISSET_W(m_sigs_enabledp, code))) return;
+        if (m_flightp) {
+            flightRecord((bits << 4) | VerilatedTraceOffloadCommand::CHG_QDATA, code, oldp, 2);
+            return;
+        }
+    }
     emitQData(code, newval, bits);
 }
 
@@ -881,7 +1073,14 @@ template <>
 void VerilatedTraceBuffer<VL_BUF_T>::fullWData(uint32_t* oldp, const WData* newvalp, int bits) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     for (int i = 0; i < VL_WORDS_I(bits); ++i) oldp[i] = newvalp[i];
-    if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_sigs_enabledp)) {
+        if (!(VL_BITISSET_W(m_sigs_enabledp, code))) return;
+        if (m_flightp) {
+            flightRecord((bits << 4) | VerilatedTraceOffloadCommand::CHG_WDATA, code, oldp,
+                         VL_WORDS_I(bits));
+            return;
+        }
+    }
     emitWData(code, newvalp, bits);
 }
 
@@ -889,11 +1088,153 @@ template <>
 void VerilatedTraceBuffer<VL_BUF_T>::fullDouble(uint32_t* oldp, double newval) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     std::memcpy(oldp, &newval, sizeof(newval));
-    if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_sigs_enabledp)) {
+        if (!(VL_BITISSET_W(m_sigs_enabledp, code))) return;
+        if (m_flightp) {
+            flightRecord(VerilatedTraceOffloadCommand::CHG_DOUBLE, code, oldp, 2);
+            return;
+        }
+    }
     // cppcheck-suppress invalidPointerCast
     emitDouble(code, newval);
 }
 
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::flightReplay(const uint32_t* readp, const uint32_t* endp) {
+    while (readp < endp) {
+        const uint32_t cmd = readp[0];
+        const uint32_t top = cmd >> 4;
+        const uint32_t code = readp[1];
+        readp += 2;
+        switch (cmd & 0xF) {
+        case VerilatedTraceOffloadCommand::CHG_BIT_0:
+        case VerilatedTraceOffloadCommand::CHG_BIT_1: emitBit(code, cmd & 1); break;
+        case VerilatedTraceOffloadCommand::CHG_CDATA: emitCData(code, *readp++, top); break;
+        case VerilatedTraceOffloadCommand::CHG_SDATA: emitSData(code, *readp++, top); break;
+        case VerilatedTraceOffloadCommand::CHG_IDATA: emitIData(code, *readp++, top); break;
+        case VerilatedTraceOffloadCommand::CHG_QDATA: {
+            QData newval;
+            std::memcpy(&newval, readp, sizeof(newval));
+            emitQData(code, newval, top);
+            readp += 2;
+            break;
+        }
+        case VerilatedTraceOffloadCommand::CHG_WDATA:
+            emitWData(code, readp, top);
+            readp += VL_WORDS_I(top);
+            break;
+        case VerilatedTraceOffloadCommand::CHG_DOUBLE: {
+            double newval;
+            std::memcpy(&newval, readp, sizeof(newval));
+            emitDouble(code, newval);
+            readp += 2;
+            break;
+        }
+        case VerilatedTraceOffloadCommand::CHG_EVENT: {
+            VlEvent newval;
+            newval.fire();
+            emitEvent(code, newval);
+            break;
+        }
+        default:  // LCOV_EXCL_START
+            VL_FATAL_MT(__FILE__, __LINE__, "", "Unknown trace command");
+            return;
+        }  // LCOV_EXCL_STOP
+    }
+}
+
+// Load 4 or 8 consecutive values, zero extended to 32-bit lanes as in the previous value store
+#ifdef VL_HAVE_SSE2
+static inline __m128i loadTraceLanes4(const CData* valuesp) {
+    int32_t packed;
+    std::memcpy(&packed, valuesp, sizeof(packed));
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+}
+static inline __m128i loadTraceLanes4(const SData* valuesp) {
+    const __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(valuesp));
+    return _mm_unpacklo_epi16(a, _mm_setzero_si128());
+}
+static inline __m128i loadTraceLanes4(const IData* valuesp) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(valuesp));
+}
+#endif
+#ifdef VL_HAVE_AVX2
+static inline __m256i loadTraceLanes8(const CData* valuesp) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(valuesp)));
+}
+static inline __m256i loadTraceLanes8(const SData* valuesp) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(valuesp)));
+}
+static inline __m256i loadTraceLanes8(const IData* valuesp) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(valuesp));
+}
+#endif
+
+// Call 'changed(i)' for each of the 'count' values at 'newvalp' that differs from its previous
+// value at 'oldp[i]'. Most values are expected to be unchanged, so compare blocks at a time.
+template <typename T_Value, typename T_Changed>
+static inline void chgTraceArray(const uint32_t* oldp, const T_Value* newvalp, int count,
+                                 T_Changed changed) {
+    int i = 0;
+#ifdef VL_HAVE_AVX2
+    for (; i + 8 <= count; i += 8) {
+        const __m256i oldv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(oldp + i));
+        const __m256i eq = _mm256_cmpeq_epi32(oldv, loadTraceLanes8(newvalp + i));
+        const int diff = ~_mm256_movemask_ps(_mm256_castsi256_ps(eq)) & 0xff;
+        if (VL_LIKELY(!diff)) continue;
+        for (int j = 0; j < 8; ++j) {
+            if (diff & (1 << j)) changed(i + j);
+        }
+    }
+#endif
+#ifdef VL_HAVE_SSE2
+    for (; i + 4 <= count; i += 4) {
+        const __m128i oldv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(oldp + i));
+        const __m128i eq = _mm_cmpeq_epi32(oldv, loadTraceLanes4(newvalp + i));
+        const int diff = ~_mm_movemask_ps(_mm_castsi128_ps(eq)) & 0xf;
+        if (VL_LIKELY(!diff)) continue;
+        for (int j = 0; j < 4; ++j) {
+            if (diff & (1 << j)) changed(i + j);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (VL_UNLIKELY(oldp[i] != newvalp[i])) changed(i);
+    }
+}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::chgBitArray(uint32_t* oldp, const CData* newvalp,
+                                                 int count) {
+    chgTraceArray(oldp, newvalp, count,
+                  [this, oldp, newvalp](int i) { fullBit(oldp + i, newvalp[i]); });
+}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::chgCDataArray(uint32_t* oldp, const CData* newvalp,
+                                                   int count, int bits) {
+    chgTraceArray(oldp, newvalp, count, [this, oldp, newvalp, bits](int i) {
+        fullCData(oldp + i, newvalp[i], bits);
+    });
+}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::chgSDataArray(uint32_t* oldp, const SData* newvalp,
+                                                   int count, int bits) {
+    chgTraceArray(oldp, newvalp, count, [this, oldp, newvalp, bits](int i) {
+        fullSData(oldp + i, newvalp[i], bits);
+    });
+}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::chgIDataArray(uint32_t* oldp, const IData* newvalp,
+                                                   int count, int bits) {
+    chgTraceArray(oldp, newvalp, count, [this, oldp, newvalp, bits](int i) {
+        fullIData(oldp + i, newvalp[i], bits);
+    });
+}
+
 //=========================================================================
 // VerilatedTraceOffloadBuffer
 
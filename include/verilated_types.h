@@ -136,9 +136,10 @@ public:
 
     // Return true iff at least one element is set
     bool any() const {
-        for (size_t i = 0; i < m_flags.size(); ++i)
-            if (m_flags[i]) return true;
-        return false;
+        // Reduce without early exit, so the loop vectorizes for large vectors
+        uint64_t result = 0;
+        for (size_t i = 0; i < m_flags.size(); ++i) result |= m_flags[i];
+        return result != 0;
     }
 
     // Set all elements true in 'this' that are set in 'other'
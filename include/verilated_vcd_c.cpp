@@ -262,6 +262,14 @@ void VerilatedVcd::flush() VL_MT_SAFE_EXCLUDES(m_mutex) {
     bufferFlush();
 }
 
+void VerilatedVcd::flightFlush() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    if (!isOpen()) return;
+    Super::flightWrite();
+    Super::flushBase();
+    bufferFlush();
+}
+
 void VerilatedVcd::printStr(const char* str) {
     // Not fast...
     while (*str) {
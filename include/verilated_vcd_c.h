@@ -134,6 +134,8 @@ public:
     void close() VL_MT_SAFE_EXCLUDES(m_mutex);
     // Flush any remaining data to this file
     void flush() VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Write the flight recorded changes to this file, then flush it
+    void flightFlush() VL_MT_SAFE_EXCLUDES(m_mutex);
     // Return if file is open
     bool isOpen() const VL_MT_SAFE { return m_isOpen; }
 
@@ -162,6 +164,8 @@ template <>
 void VerilatedVcd::Super::set_time_resolution(const std::string& unit);
 template <>
 void VerilatedVcd::Super::dumpvars(int level, const std::string& hier);
+template <>
+void VerilatedVcd::Super::flightRecorder(size_t maxDumps, size_t maxBytes);
 #endif  // DOXYGEN
 
 //=============================================================================
@@ -275,6 +279,16 @@ public:
     /// alignment to a start of a given time's dump).  Any file but the
     /// first may be removed.  Cat files together to create viewable vcd.
     void rolloverSize(size_t size) VL_MT_SAFE { m_sptrace.rolloverSize(size); }
+    /// Record value changes in memory instead of writing them to the file,
+    /// keeping only the last maxDumps calls to dump(), using up to about
+    /// maxBytes of memory (0 = no limit). The recorded changes are only
+    /// written by flightFlush(), which is also called on $stop, $fatal,
+    /// failing assertions and $dumpflush. Must be called before open().
+    void flightRecorder(size_t maxDumps, size_t maxBytes = 0) VL_MT_SAFE {
+        m_sptrace.flightRecorder(maxDumps, maxBytes);
+    }
+    /// Write the changes recorded by flightRecorder() to the file, then flush it
+    void flightFlush() VL_MT_SAFE { m_sptrace.flightFlush(); }
     /// Close dump
     void close() VL_MT_SAFE { m_sptrace.close(); }
     /// Flush dump
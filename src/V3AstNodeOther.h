@@ -1154,6 +1154,7 @@ class AstNetlist final : public AstNode {
     AstCFunc* m_evalNbap = nullptr;  // The '_eval__nba' function
     AstVarScope* m_dpiExportTriggerp = nullptr;  // The DPI export trigger variable
     AstVar* m_delaySchedulerp = nullptr;  // The delay scheduler variable
+    AstVar* m_evalsSkippedp = nullptr;  // The count of skipped evaluations
     AstTopScope* m_topScopep = nullptr;  // The singleton AstTopScope under the top module
     VTimescale m_timeunit;  // Global time unit
     VTimescale m_timeprecision;  // Global time precision
@@ -1183,6 +1184,8 @@ public:
     void dpiExportTriggerp(AstVarScope* varScopep) { m_dpiExportTriggerp = varScopep; }
     AstVar* delaySchedulerp() const { return m_delaySchedulerp; }
     void delaySchedulerp(AstVar* const varScopep) { m_delaySchedulerp = varScopep; }
+    AstVar* evalsSkippedp() const { return m_evalsSkippedp; }
+    void evalsSkippedp(AstVar* const varp) { m_evalsSkippedp = varp; }
     void stdPackagep(AstPackage* const packagep) { m_stdPackagep = packagep; }
     AstPackage* stdPackagep() const { return m_stdPackagep; }
     AstTopScope* topScopep() const { return m_topScopep; }
@@ -1631,6 +1634,7 @@ class AstVar final : public AstNode {
     VLifetime m_lifetime;  // Lifetime
     VVarAttrClocker m_attrClocker;
     MTaskIdSet m_mtaskIds;  // MTaskID's that read or write this var
+    MTaskIdSet m_producingMTaskIds;  // MTaskID's that write this var
     int m_pinNum = 0;  // For XML, if non-zero the connection pin number
     bool m_ansi : 1;  // ANSI port list variable (for dedup check)
     bool m_declTyped : 1;  // Declared as type (for dedup check)
@@ -1674,6 +1678,7 @@ class AstVar final : public AstNode {
     bool m_isForceable : 1;  // May be forced/released externally from user C code
     bool m_isWrittenByDpi : 1;  // This variable can be written by a DPI Export
     bool m_isWrittenBySuspendable : 1;  // This variable can be written by a suspendable process
+    bool m_alignCacheLine : 1;  // Emit aligned to start a new cache line
 
     void init() {
         m_ansi = false;
@@ -1718,6 +1723,7 @@ class AstVar final : public AstNode {
         m_isForceable = false;
         m_isWrittenByDpi = false;
         m_isWrittenBySuspendable = false;
+        m_alignCacheLine = false;
         m_attrClocker = VVarAttrClocker::CLOCKER_UNKNOWN;
     }
 
@@ -1883,6 +1889,8 @@ public:
     void setWrittenByDpi() { m_isWrittenByDpi = true; }
     bool isWrittenBySuspendable() const { return m_isWrittenBySuspendable; }
     void setWrittenBySuspendable() { m_isWrittenBySuspendable = true; }
+    bool alignCacheLine() const { return m_alignCacheLine; }
+    void alignCacheLine(bool flag) { m_alignCacheLine = flag; }
 
     // METHODS
     void name(const string& name) override { m_name = name; }
@@ -1985,9 +1993,13 @@ public:
         m_name = name;
     }
     static AstVar* scVarRecurse(AstNode* nodep);
-    void addProducingMTaskId(int id) { m_mtaskIds.insert(id); }
+    void addProducingMTaskId(int id) {
+        m_mtaskIds.insert(id);
+        m_producingMTaskIds.insert(id);
+    }
     void addConsumingMTaskId(int id) { m_mtaskIds.insert(id); }
     const MTaskIdSet& mtaskIds() const { return m_mtaskIds; }
+    const MTaskIdSet& producingMTaskIds() const { return m_producingMTaskIds; }
     void pinNum(int id) { m_pinNum = id; }
     int pinNum() const { return m_pinNum; }
 };
@@ -2248,6 +2260,7 @@ public:
 class AstAlways final : public AstNodeProcedure {
     // @astgen op1 := sensesp : Optional[AstSenTree] // Sensitivity list iff clocked
     const VAlwaysKwd m_keyword;
+    bool m_settleLoop = false;  // Iterates until its own outputs are stable (V3SchedAcyclic)
 
 public:
     AstAlways(FileLine* fl, VAlwaysKwd keyword, AstSenTree* sensesp, AstNode* stmtsp)
@@ -2259,6 +2272,8 @@ public:
     //
     void dump(std::ostream& str) const override;
     VAlwaysKwd keyword() const { return m_keyword; }
+    bool isSettleLoop() const { return m_settleLoop; }
+    void setSettleLoop() { m_settleLoop = true; }
 };
 class AstAlwaysObserved final : public AstNodeProcedure {
     // Like always but Observed scheduling region
@@ -1348,6 +1348,7 @@ void AstNodeProcedure::dump(std::ostream& str) const {
 void AstAlways::dump(std::ostream& str) const {
     this->AstNodeProcedure::dump(str);
     if (keyword() != VAlwaysKwd::ALWAYS) str << " [" << keyword().ascii() << "]";
+    if (isSettleLoop()) str << " [SETTLE]";
 }
 
 void AstAttrOf::dump(std::ostream& str) const {
@@ -1873,6 +1874,7 @@ const char* AstNetlist::broken() const {
     BROKEN_RTN(m_dpiExportTriggerp && !m_dpiExportTriggerp->brokeExists());
     BROKEN_RTN(m_topScopep && !m_topScopep->brokeExists());
     BROKEN_RTN(m_delaySchedulerp && !m_delaySchedulerp->brokeExists());
+    BROKEN_RTN(m_evalsSkippedp && !m_evalsSkippedp->brokeExists());
     return nullptr;
 }
 AstPackage* AstNetlist::dollarUnitPkgAddp() {
@@ -23,6 +23,8 @@
 //                      Add a __Vlast_{clock} for the comparison
 //                      Set the __Vlast_{clock} at the end of the block
 //              Replace UNTILSTABLEs with loops until specified signals become const.
+//      Group runs of IFs testing bits of the same trigger word under one
+//      IF testing all those bits, so unset trigger words are skipped at once
 //   Create global calling function for any per-scope functions.  (For FINALs).
 //
 //*************************************************************************
@@ -35,6 +37,7 @@
 #include "V3Ast.h"
 #include "V3Global.h"
 #include "V3Sched.h"
+#include "V3Stats.h"
 
 #include <algorithm>
 
@@ -68,6 +71,93 @@ public:
     static AstNodeExpr* main(AstNodeExpr* nodep) { return ConvertWriteRefsToRead{nodep}.m_result; }
 };
 
+//######################################################################
+// Group consecutive trigger tests of the same trigger word
+
+class ClockTriggerGroup final {
+    // Only group runs at least this long, otherwise the extra test is not worth it
+    static constexpr size_t GROUP_MIN_IFS = 3;
+
+    // STATE
+    VDouble0 m_statGroups;  // Statistic tracking
+
+    // METHODS
+    // If 'condp' only tests bits of a single trigger vector word, return the 'word' call, and
+    // accumulate the tested bits into 'mask', otherwise return nullptr.
+    static AstCMethodHard* triggerWordp(AstNodeExpr* condp, uint64_t& mask) {
+        if (AstOr* const orp = VN_CAST(condp, Or)) {
+            AstCMethodHard* const lhsp = triggerWordp(orp->lhsp(), mask);
+            AstCMethodHard* const rhsp = triggerWordp(orp->rhsp(), mask);
+            return lhsp && rhsp && sameWord(lhsp, rhsp) ? lhsp : nullptr;
+        }
+        AstAnd* const andp = VN_CAST(condp, And);
+        if (!andp) return nullptr;
+        AstConst* const constp = VN_CAST(andp->lhsp(), Const);
+        AstCMethodHard* const callp = VN_CAST(andp->rhsp(), CMethodHard);
+        if (!constp || !callp || callp->name() != "word") return nullptr;
+        const AstBasicDType* const basicp = callp->fromp()->dtypep()->basicp();
+        if (!basicp || !basicp->isTriggerVec()) return nullptr;
+        if (!VN_IS(callp->fromp(), VarRef) || !VN_IS(callp->pinsp(), Const)) return nullptr;
+        mask |= constp->num().toUQuad();
+        return callp;
+    }
+    static bool sameWord(const AstCMethodHard* ap, const AstCMethodHard* bp) {
+        return VN_AS(ap->fromp(), VarRef)->varScopep() == VN_AS(bp->fromp(), VarRef)->varScopep()
+               && VN_AS(ap->pinsp(), Const)->toUInt() == VN_AS(bp->pinsp(), Const)->toUInt();
+    }
+    static AstCMethodHard* ifWordp(AstNode* nodep, uint64_t& mask) {
+        AstIf* const ifp = VN_CAST(nodep, If);
+        if (!ifp || ifp->elsesp()) return nullptr;
+        return triggerWordp(ifp->condp(), mask);
+    }
+
+public:
+    // Group trigger tests in the given statement list
+    void group(AstNode* stmtsp) {
+        AstNode* nodep = stmtsp;
+        while (nodep) {
+            uint64_t mask = 0;
+            AstCMethodHard* const wordp = ifWordp(nodep, mask);
+            if (!wordp) {
+                nodep = nodep->nextp();
+                continue;
+            }
+            // Find the end of the run testing the same word
+            AstNode* lastp = nodep;
+            size_t nIfs = 1;
+            while (lastp->nextp()) {
+                uint64_t nextMask = 0;
+                AstCMethodHard* const nextWordp = ifWordp(lastp->nextp(), nextMask);
+                if (!nextWordp || !sameWord(wordp, nextWordp)) break;
+                mask |= nextMask;
+                lastp = lastp->nextp();
+                ++nIfs;
+            }
+            AstNode* const restp = lastp->nextp();
+            if (nIfs < GROUP_MIN_IFS) {
+                nodep = restp;
+                continue;
+            }
+            // Move the run under a single test of all bits tested in the run
+            FileLine* const flp = nodep->fileline();
+            if (restp) restp->unlinkFrBackWithNext();
+            VNRelinker relinker;
+            nodep->unlinkFrBackWithNext(&relinker);
+            AstNodeExpr* const condp = new AstAnd{
+                flp, new AstConst{flp, AstConst::Unsized64{}, mask}, wordp->cloneTree(false)};
+            AstIf* const groupp = new AstIf{flp, condp, nodep};
+            relinker.relink(groupp);
+            if (restp) groupp->addNextHere(restp);
+            ++m_statGroups;
+            nodep = restp;
+        }
+    }
+
+    // CONSTRUCTORS
+    ClockTriggerGroup() = default;
+    ~ClockTriggerGroup() { V3Stats::addStat("Optimizations, Trigger test groups", m_statGroups); }
+};
+
 //######################################################################
 // Clock state, as a visitor of each AstNode
 
@@ -79,6 +169,7 @@ private:
     AstSenTree* m_lastSenp = nullptr;  // Last sensitivity match, so we can detect duplicates.
     AstIf* m_lastIfp = nullptr;  // Last sensitivity if active to add more under
     bool m_inSampled = false;  // True inside a sampled expression
+    ClockTriggerGroup m_triggerGroup;  // Trigger test grouping
 
     // METHODS
 
@@ -172,9 +263,14 @@ private:
              mtaskBodyp = VN_AS(mtaskBodyp->nextp(), MTaskBody)) {
             clearLastSen();
             iterate(mtaskBodyp);
+            m_triggerGroup.group(mtaskBodyp->stmtsp());
         }
         clearLastSen();
     }
+    void visit(AstCFunc* nodep) override {
+        iterateChildren(nodep);
+        m_triggerGroup.group(nodep->stmtsp());
+    }
 
     //========== Create sampled values
     void visit(AstScope* nodep) override {
@@ -621,8 +621,9 @@ public:
             // $dumpall currently ignored
             break;
         case VDumpCtlType::FLUSH:
-            // $dumpall currently ignored; would need rework of VCD single thread,
-            // or flag we pass-through to next eval() iteration
+            // Writes what has been dumped so far, as of the last dump() call,
+            // including any flight recorded changes
+            puts("Verilated::runDumpFlushCallbacks();\n");
             break;
         case VDumpCtlType::LIMIT:
             // $dumplimit currently ignored
@@ -56,7 +56,13 @@ class EmitCHeader final : public EmitCConstInit {
         std::vector<const AstVar*> varList;
         bool lastAnon = false;  // initial value is not important, but is used
 
-        const auto emitCurrentList = [this, &first, &varList, &lastAnon]() {
+        // Start a new cache line where V3VariableOrder requested it
+        const auto emitVar = [this](const AstVar* varp) {
+            if (varp->alignCacheLine()) puts("alignas(VL_CACHE_LINE_BYTES) ");
+            emitVarDecl(varp);
+        };
+
+        const auto emitCurrentList = [this, &first, &varList, &lastAnon, &emitVar]() {
             if (varList.empty()) return;
 
             decorateFirst(first, "\n// DESIGN SPECIFIC STATE\n");
@@ -87,7 +93,7 @@ class EmitCHeader final : public EmitCConstInit {
                         for (int l1 = 0; l1 < anonL1s && it != varList.cend(); ++l1) {
                             if (anonL1s != 1) puts("struct {\n");
                             for (int l0 = 0; l0 < lim && it != varList.cend(); ++l0) {
-                                emitVarDecl(*it);
+                                emitVar(*it);
                                 ++it;
                             }
                             if (anonL1s != 1) puts("};\n");
@@ -97,9 +103,9 @@ class EmitCHeader final : public EmitCConstInit {
                     if (anonL3s != 1) puts("};\n");
                 }
                 // Leftovers, just in case off by one error somewhere above
-                for (; it != varList.cend(); ++it) emitVarDecl(*it);
+                for (; it != varList.cend(); ++it) emitVar(*it);
             } else {  // Output as nonanons
-                for (const auto& pair : varList) emitVarDecl(pair);
+                for (const auto& pair : varList) emitVar(pair);
             }
 
             varList.clear();
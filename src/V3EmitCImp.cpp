@@ -274,7 +274,11 @@ class EmitCImp final : EmitCFunc {
                     } else if (dtypep->isDelayScheduler()) {
                         puts(", ");
                         puts(varp->nameProtect());
-                        puts("{*symsp->_vm_contextp__}\n");
+                        puts("{*symsp->_vm_contextp__");
+                        if (v3Global.opt.timingWheel()) {
+                            puts(", " + cvtToStr(v3Global.opt.timingWheel()));
+                        }
+                        puts("}\n");
                     }
                 }
             }
@@ -884,7 +888,41 @@ class EmitCTrace final : EmitCFunc {
             puts("\n");
         }
     }
+    bool emitTraceChangeArray(AstTraceInc* nodep) {
+        // Changes of an array of narrow elements are checked with a single call, that compares
+        // the elements to their consecutive previous values in blocks
+        if (nodep->full() || v3Global.opt.useTraceOffload()) return false;
+        if (nodep->declp()->arrayRange().elements() < 4) return false;
+        const AstVarRef* const varrefp = VN_CAST(nodep->valuep(), VarRef);
+        if (!varrefp || varrefp->varp()->isSc()) return false;
+        if (!VN_IS(varrefp->varp()->dtypeSkipRefp(), UnpackArrayDType)) return false;
+        const AstBasicDType* const basicp = nodep->dtypep()->basicp();
+        if (!basicp || basicp->isDouble() || basicp->isEvent()) return false;
+        if (nodep->isWide() || nodep->isQuad()) return false;
+
+        iterateAndNextConstNull(nodep->precondsp());
+        const int width = nodep->declp()->widthMin();
+        if (width > 16) {
+            puts("bufp->chgIDataArray");
+        } else if (width > 8) {
+            puts("bufp->chgSDataArray");
+        } else if (width > 1) {
+            puts("bufp->chgCDataArray");
+        } else {
+            puts("bufp->chgBitArray");
+        }
+        puts("(oldp+");
+        puts(cvtToStr(nodep->declp()->code() - nodep->baseCode()));
+        puts(",&");
+        emitTraceValue(nodep, -1);
+        puts("," + cvtToStr(nodep->declp()->arrayRange().elements()));
+        if (width > 1) puts("," + cvtToStr(width));
+        puts(");\n");
+        return true;
+    }
+
     void visit(AstTraceInc* nodep) override {
+        if (emitTraceChangeArray(nodep)) return;
         if (nodep->declp()->arrayRange().ranged()) {
             // It traces faster if we unroll the loop
             for (int i = 0; i < nodep->declp()->arrayRange().elements(); i++) {
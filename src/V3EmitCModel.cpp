@@ -48,6 +48,20 @@ class EmitCModel final : public EmitCFunc {
         return funcps;
     }
 
+    // The top level input driven by runCycles, or nullptr if none
+    static const AstVar* runCyclesClockp(AstNodeModule* modp) {
+        if (v3Global.opt.runCycles().empty()) return nullptr;
+        for (const AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+            if (const AstVar* const varp = VN_CAST(nodep, Var)) {
+                if (varp->isPrimaryIO() && varp->isNonOutput() && varp->width() == 1
+                    && varp->name() == v3Global.opt.runCycles()) {
+                    return varp;
+                }
+            }
+        }
+        return nullptr;
+    }
+
     void putSectionDelimiter(const string& name) {
         puts("\n");
         puts("//============================================================\n");
@@ -194,6 +208,26 @@ class EmitCModel final : public EmitCFunc {
         puts("bool eventsPending();\n");
         puts("/// Returns time at next time slot. Aborts if !eventsPending()\n");
         puts("uint64_t nextTimeSlot();\n");
+        if (v3Global.opt.evalSkipUnchanged()) {
+            puts("/// Number of eval() calls skipped as no inputs changed\n");
+            puts("uint64_t evalsSkipped() const;\n");
+        }
+
+        if (!v3Global.opt.runCycles().empty()) {
+            if (const AstVar* const clockp = runCyclesClockp(modp)) {
+                puts("/// Run 'cycles' cycles of '" + clockp->nameProtect()
+                     + "', each setting it high then low,\n");
+                puts("/// calling eval() and advancing time by 'timeStep' after each edge.\n");
+                puts("/// Calls 'callbackp(userp)' every 'interval' cycles if given.\n");
+                puts("/// Returns the number of complete cycles run, fewer on $finish or $stop.\n");
+                puts("uint64_t runCycles(uint64_t cycles, uint64_t timeStep = 1, "
+                     "uint64_t interval = 0,\n");
+                puts("void (*callbackp)(void*) = nullptr, void* userp = nullptr);\n");
+            } else {
+                v3error("--run-cycles signal is not a one bit top level input: '"
+                        << v3Global.opt.runCycles() << "'");
+            }
+        }
 
         if (v3Global.opt.trace()) {
             puts("/// Trace signals in the model; called by application code\n");
@@ -422,6 +456,42 @@ class EmitCModel final : public EmitCFunc {
         puts("}\n");
     }
 
+    void emitRunCycles(const AstVar* clockp) {
+        putSectionDelimiter("Run cycles");
+        const string clockName = clockp->nameProtect();
+        puts("\nuint64_t " + topClassName()
+             + "::runCycles(uint64_t cycles, uint64_t timeStep, uint64_t interval,\n");
+        puts("void (*callbackp)(void*), void* userp) {\n");
+        puts("VerilatedContext* const contextp = vlSymsp->_vm_contextp__;\n");
+        putsDecoration("// Evaluate one edge, and any delays ending before the next\n");
+        puts("const auto edge = [&](CData value) -> bool {\n");
+        puts(clockName + " = value;\n");
+        puts("eval();\n");
+        puts("const uint64_t nextTime = contextp->time() + timeStep;\n");
+        if (v3Global.rootp()->delaySchedulerp()) {
+            puts("while (!contextp->gotFinish() && eventsPending() "
+                 "&& nextTimeSlot() < nextTime) {\n");
+            puts("contextp->time(nextTimeSlot());\n");
+            puts("eval();\n");
+            puts("}\n");
+        }
+        puts("if (VL_UNLIKELY(contextp->gotFinish())) return false;\n");
+        puts("contextp->time(nextTime);\n");
+        puts("return true;\n");
+        puts("};\n");
+        puts("uint64_t untilCallback = interval;\n");
+        puts("for (uint64_t cycle = 0; cycle < cycles; ++cycle) {\n");
+        puts("if (VL_UNLIKELY(!edge(1) || !edge(0))) return cycle;\n");
+        puts("if (callbackp && interval && !--untilCallback) {\n");
+        puts("untilCallback = interval;\n");
+        puts("callbackp(userp);\n");
+        puts("if (VL_UNLIKELY(contextp->gotFinish())) return cycle + 1;\n");
+        puts("}\n");
+        puts("}\n");
+        puts("return cycles;\n");
+        puts("}\n");
+    }
+
     void emitStandardMethods2(AstNodeModule* modp) {
         const string topModNameProtected = prefixNameProtect(modp);
         const string selfDecl = "(" + topModNameProtected + "* vlSelf)";
@@ -454,6 +524,16 @@ class EmitCModel final : public EmitCFunc {
                  "design\");\n");
             puts("return 0;\n}\n");
         }
+        if (v3Global.opt.evalSkipUnchanged()) {
+            puts("\nuint64_t " + topClassName() + "::evalsSkipped() const { return ");
+            if (const AstVar* const varp = v3Global.rootp()->evalsSkippedp()) {
+                puts("vlSymsp->TOP." + varp->nameProtect() + "; }\n");
+            } else {
+                puts("0; }\n");
+            }
+        }
+
+        if (const AstVar* const clockp = runCyclesClockp(modp)) emitRunCycles(clockp);
 
         putSectionDelimiter("Utilities");
 
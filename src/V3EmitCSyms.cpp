@@ -472,6 +472,7 @@ void EmitCSyms::emitSymHdr() {
         puts("bool __Vm_even_cycle__ico = false;\n");
         puts("bool __Vm_even_cycle__act = false;\n");
         puts("bool __Vm_even_cycle__nba = false;\n");
+        puts("bool __Vm_even_cycle__stl = false;\n");
     }
 
     if (v3Global.opt.profExec()) {
@@ -814,6 +815,11 @@ void EmitCSyms::emitSymImp() {
         }
     }
 
+    if (v3Global.opt.profExec() && v3Global.usesTiming()) {
+        puts("// Report coroutine frame allocations in the execution profile\n");
+        puts("__Vm_executionProfilerp->frameCountsCb(&VlCoroutineFramePool::counts);\n");
+    }
+
     puts("// Configure time unit / time precision\n");
     if (!v3Global.rootp()->timeunit().isNone()) {
         puts("_vm_contextp__->timeunit(");
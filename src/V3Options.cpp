@@ -806,6 +806,10 @@ void V3Options::notify() {
         cmdfl->v3error("--make cannot be used together with --build. Suggest see manual");
     }
 
+    if (!m_runCycles.empty() && m_systemC) {
+        cmdfl->v3error("--run-cycles cannot be used together with --sc. Suggest see manual");
+    }
+
     if (m_exe && !v3Global.opt.libCreate().empty()) {
         cmdfl->v3error("--exe cannot be used together with --lib-create. Suggest see manual");
     }
@@ -860,8 +864,8 @@ void V3Options::notify() {
         // With --trace-fst, --trace-threads implies --threads 1 unless explicitly specified
         if (traceFormat().fst() && traceThreads() && !threads()) m_threads = 1;
 
-        // With --trace, --trace-threads is ignored
-        if (traceFormat().vcd()) m_traceThreads = threads() ? 1 : 0;
+        // With --trace or --trace-bin, --trace-threads is ignored
+        if (!traceFormat().fst()) m_traceThreads = threads() ? 1 : 0;
     }
 
     UASSERT(!(useTraceParallel() && useTraceOffload()),
@@ -1072,6 +1076,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
                 [this](const char* optp) { addLangExt(optp, V3LangCode::L1800_2017); });
 
     // Minus options
+    DECL_OPTION("-activity-gating", OnOff, &m_activityGating);
     DECL_OPTION("-assert", OnOff, &m_assert);
     DECL_OPTION("-autoflush", OnOff, &m_autoflush);
 
@@ -1157,6 +1162,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     DECL_OPTION("-debug-leak", OnOff, &m_debugLeak);
     DECL_OPTION("-debug-nondeterminism", OnOff, &m_debugNondeterminism);
     DECL_OPTION("-debug-partition", OnOff, &m_debugPartition).undocumented();
+    DECL_OPTION("-debug-partition-benchmark", Set, &m_debugPartitionBenchmark).undocumented();
     DECL_OPTION("-debug-protect", OnOff, &m_debugProtect).undocumented();
     DECL_OPTION("-debug-self-test", OnOff, &m_debugSelfTest).undocumented();
     DECL_OPTION("-debug-sigsegv", CbCall, throwSigsegv).undocumented();  // See also --debug-abort
@@ -1172,6 +1178,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
         m_preprocOnly = flag;
     });
     DECL_OPTION("-error-limit", CbVal, static_cast<void (*)(int)>(&V3Error::errorLimit));
+    DECL_OPTION("-eval-skip-unchanged", OnOff, &m_evalSkipUnchanged);
     DECL_OPTION("-exe", OnOff, &m_exe);
     DECL_OPTION("-expand-limit", CbVal,
                 [this](const char* valp) { m_expandLimit = std::atoi(valp); });
@@ -1220,11 +1227,16 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     DECL_OPTION("-fmerge-const-pool", FOnOff, &m_fMergeConstPool);
     DECL_OPTION("-freloop", FOnOff, &m_fReloop);
     DECL_OPTION("-freorder", FOnOff, &m_fReorder);
+    DECL_OPTION("-fsched-parallel-settle", FOnOff, &m_fSchedParallelSettle);
+    DECL_OPTION("-fsched-scc-settle", FOnOff, &m_fSchedSccSettle);
+    DECL_OPTION("-fsched-single-clock", FOnOff, &m_fSchedSingleClock);
     DECL_OPTION("-fsplit", FOnOff, &m_fSplit);
     DECL_OPTION("-fsubst", FOnOff, &m_fSubst);
     DECL_OPTION("-fsubst-const", FOnOff, &m_fSubstConst);
     DECL_OPTION("-ftable", FOnOff, &m_fTable);
     DECL_OPTION("-ftaskify-all-forked", FOnOff, &m_fTaskifyAll).undocumented();  // Debug
+    DECL_OPTION("-ftiming-parallel", FOnOff, &m_fTimingParallel);
+    DECL_OPTION("-ftiming-trigger-deps", FOnOff, &m_fTimingTriggerDeps);
 
     DECL_OPTION("-G", CbPartialMatch, [this](const char* optp) { addParameter(optp, false); });
     DECL_OPTION("-gate-stmts", Set, &m_gateStmts);
@@ -1424,6 +1436,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     });
     DECL_OPTION("-report-unoptflat", OnOff, &m_reportUnoptflat);
     DECL_OPTION("-rr", CbCall, []() {});  // Processed only in bin/verilator shell
+    DECL_OPTION("-run-cycles", Set, &m_runCycles);
 
     DECL_OPTION("-savable", OnOff, &m_savable);
     DECL_OPTION("-sc", CbCall, [this]() {
@@ -1453,6 +1466,17 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
             m_threads = 1;
         }
     });
+    DECL_OPTION("-threads-contraction", CbVal, [this, fl](const char* valp) {
+        if (!std::strcmp(valp, "precise")) {
+            m_threadsFastContraction = false;
+        } else if (!std::strcmp(valp, "fast")) {
+            m_threadsFastContraction = true;
+        } else {
+            fl->v3fatal("Unknown setting for --threads-contraction: '"
+                        << valp << "'\n"
+                        << fl->warnMore() << "... Suggest 'precise' or 'fast'");
+        }
+    });
     DECL_OPTION("-threads-dpi", CbVal, [this, fl](const char* valp) {
         if (!std::strcmp(valp, "all")) {
             m_threadsDpiPure = true;
@@ -1469,10 +1493,28 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
                         << fl->warnMore() << "... Suggest 'all', 'none', or 'pure'");
         }
     });
+    DECL_OPTION("-threads-footprint-weight", CbVal, [this, fl](const char* valp) {
+        m_threadsFootprintWeight = std::atoi(valp);
+        if (m_threadsFootprintWeight < 0) {
+            fl->v3fatal("--threads-footprint-weight must be >= 0: " << valp);
+        }
+    });
     DECL_OPTION("-threads-max-mtasks", CbVal, [this, fl](const char* valp) {
         m_threadsMaxMTasks = std::atoi(valp);
         if (m_threadsMaxMTasks < 1) fl->v3fatal("--threads-max-mtasks must be >= 1: " << valp);
     });
+    DECL_OPTION("-threads-schedule", CbVal, [this, fl](const char* valp) {
+        if (!std::strcmp(valp, "static")) {
+            m_threadsDynamic = false;
+        } else if (!std::strcmp(valp, "dynamic")) {
+            m_threadsDynamic = true;
+        } else {
+            fl->v3fatal("Unknown setting for --threads-schedule: '"
+                        << valp << "'\n"
+                        << fl->warnMore() << "... Suggest 'static' or 'dynamic'");
+        }
+    });
+    DECL_OPTION("-threads-var-layout", OnOff, &m_threadsVarLayout);
     DECL_OPTION("-timescale", CbVal, [this, fl](const char* valp) {
         VTimescale unit;
         VTimescale prec;
@@ -1494,9 +1536,19 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
         }
     });
     DECL_OPTION("-timing", OnOff, &m_timing);
+    DECL_OPTION("-timing-wheel", CbVal, [this, fl](const char* valp) {
+        m_timingWheel = std::atoi(valp);
+        if (m_timingWheel != 0 && (m_timingWheel < 64 || (m_timingWheel & (m_timingWheel - 1)))) {
+            fl->v3fatal("--timing-wheel must be 0 or a power of two >= 64: " << valp);
+        }
+    });
     DECL_OPTION("-top-module", Set, &m_topModule);
     DECL_OPTION("-top", Set, &m_topModule);
     DECL_OPTION("-trace", OnOff, &m_trace);
+    DECL_OPTION("-trace-bin", CbCall, [this]() {
+        m_trace = true;
+        m_traceFormat = TraceFormat::BIN;
+    });
     DECL_OPTION("-trace-coverage", OnOff, &m_traceCoverage);
     DECL_OPTION("-trace-depth", Set, &m_traceDepth);
     DECL_OPTION("-trace-fst", CbCall, [this]() {
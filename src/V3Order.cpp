@@ -152,7 +152,7 @@ public:
 
 class OrderBuildVisitor final : public VNVisitor {
     // TYPES
-    enum VarUsage : uint8_t { VU_CON = 0x1, VU_GEN = 0x2 };
+    enum VarUsage : uint8_t { VU_CON = 0x1, VU_GEN = 0x2, VU_SETTLE = 0x4 };
     using VarVertexType = OrderUser::VarVertexType;
 
     // NODE STATE
@@ -189,6 +189,14 @@ class OrderBuildVisitor final : public VNVisitor {
         UASSERT_OBJ(!m_logicVxp, nodep, "Should not nest");
         // Reset VarUsage
         AstNode::user2ClearTree();
+        // Logic settling a combinational loop iterates until its own outputs are stable (see
+        // V3SchedAcyclic), so it does not consume any variable it produces
+        const AstAlways* const alwaysp = VN_CAST(nodep, Always);
+        if (alwaysp && alwaysp->isSettleLoop()) {
+            nodep->foreach([](const AstNodeVarRef* refp) {
+                if (refp->access().isWriteOrRW()) refp->varScopep()->user2(VU_SETTLE);
+            });
+        }
         // Create LogicVertex for this logic node
         m_logicVxp = new OrderLogicVertex{m_graphp, m_scopep, m_domainp, m_hybridp, nodep};
         // Gather variable dependencies based on usage
@@ -284,6 +292,7 @@ class OrderBuildVisitor final : public VNVisitor {
                 //       latch?).
                 con = false;
             }
+            if (varscp->user2() & VU_SETTLE) con = false;
         }
 
         // Note: See V3OrderGraph.h about the roles of the various vertex types
@@ -1332,23 +1341,35 @@ void OrderProcess::processMTasks() {
         // Since we happen to be iterating over every logic node,
         // take this opportunity to annotate each AstVar with the id's
         // of mtasks that consume it and produce it. We'll use this
-        // information in V3EmitC when we lay out var's in memory.
+        // information in V3VariableOrder when we lay out var's in memory.
+        // Edges between VarStd and logic follow the data flow. In-edges
+        // from VarPre are reads, from VarPost (combinational producer)
+        // and VarPord (clocked producer) are writes. Out-edges to VarPre
+        // and VarPost are reads by clocked logic, to VarPord are writes.
         const OrderLogicVertex* const logicp = movep->logicp();
         for (const V3GraphEdge* edgep = logicp->inBeginp(); edgep; edgep = edgep->inNextp()) {
             const OrderVarVertex* const pre_varp
                 = dynamic_cast<const OrderVarVertex*>(edgep->fromp());
             if (!pre_varp) continue;
             AstVar* const varp = pre_varp->vscp()->varp();
-            // varp depends on logicp, so logicp produces varp,
-            // and vice-versa below
-            varp->addProducingMTaskId(mtaskId);
+            if (dynamic_cast<const OrderVarPostVertex*>(pre_varp)
+                || dynamic_cast<const OrderVarPordVertex*>(pre_varp)) {
+                varp->addProducingMTaskId(mtaskId);
+            } else {
+                varp->addConsumingMTaskId(mtaskId);
+            }
         }
         for (const V3GraphEdge* edgep = logicp->outBeginp(); edgep; edgep = edgep->outNextp()) {
             const OrderVarVertex* const post_varp
                 = dynamic_cast<const OrderVarVertex*>(edgep->top());
             if (!post_varp) continue;
             AstVar* const varp = post_varp->vscp()->varp();
-            varp->addConsumingMTaskId(mtaskId);
+            if (dynamic_cast<const OrderVarPreVertex*>(post_varp)
+                || dynamic_cast<const OrderVarPostVertex*>(post_varp)) {
+                varp->addConsumingMTaskId(mtaskId);
+            } else {
+                varp->addProducingMTaskId(mtaskId);
+            }
         }
         // TODO? We ignore IO vars here, so those will have empty mtask
         // signatures. But we could also give those mtask signatures.
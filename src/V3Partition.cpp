@@ -30,10 +30,13 @@
 #include "V3PartitionGraph.h"
 #include "V3Scoreboard.h"
 #include "V3Stats.h"
+#include "V3ThreadPool.h"
 #include "V3UniqueNames.h"
 
 #include <algorithm>
 #include <array>
+#include <iterator>
+#include <limits>
 #include <list>
 #include <memory>
 #include <type_traits>
@@ -131,6 +134,19 @@ constexpr unsigned PART_SIBLING_EDGE_LIMIT = 26;
 //  (# of threads * PART_DEFAULT_MAX_MTASKS_PER_THREAD)
 constexpr unsigned PART_DEFAULT_MAX_MTASKS_PER_THREAD = 50;
 
+//   PART_COARSEN_COST_DIVISOR
+//
+// With '--threads-contraction fast', chains of mtasks are merged before
+// the precise contraction, up to a cost of (cpLimit / this). Keeping the
+// coarsened mtasks well below the critical path limit leaves the precise
+// contraction free to choose how to combine them.
+constexpr unsigned PART_COARSEN_COST_DIVISOR = 8;
+
+//   PART_COARSEN_HEADS_PER_JOB
+//
+// Number of chain heads each V3ThreadPool job searches when coarsening.
+constexpr size_t PART_COARSEN_HEADS_PER_JOB = 4096;
+
 //   end tunables.
 
 //######################################################################
@@ -184,6 +200,7 @@ class LogicMTask final : public AbstractLogicMTask {
 public:
     // TYPES
     using VxList = std::list<MTaskMoveVertex*>;
+    using Footprint = std::vector<std::pair<const AstVarScope*, uint32_t>>;
 
     struct CmpLogicMTask {
         bool operator()(const LogicMTask* ap, const LogicMTask* bp) const {
@@ -221,6 +238,10 @@ private:
     // Store the outgoing and incoming edges in a heap sorted by the critical path length
     std::array<EdgeHeap, GraphWay::NUM_WAYS> m_edgeHeap;
 
+    // Variables referenced by this mtask, with their size in bytes, sorted by
+    // variable. Only gathered with --threads-footprint-weight.
+    Footprint m_footprint;
+
     // MTasks for which a SiblingMC exists with 'this' as the higher ID MTask (m_ap in SiblingMC)
     std::set<LogicMTask*> m_siblings;
     // List of SiblingMCs for which this is the higher ID MTask (m_ap in SiblingMC)
@@ -237,6 +258,16 @@ public:
             m_mvertices.push_back(mtmvVxp);
             if (const OrderLogicVertex* const olvp = mtmvVxp->logicp()) {
                 m_cost += V3InstrCount::count(olvp->nodep(), true);
+                if (v3Global.opt.threadsFootprintWeight()) {
+                    olvp->nodep()->foreach([this](const AstVarRef* refp) {
+                        const AstVar* const varp = refp->varp();
+                        const int bytes = varp->dtypeSkipRefp()->widthTotalBytes();
+                        m_footprint.emplace_back(refp->varScopep(), bytes);
+                    });
+                    std::sort(m_footprint.begin(), m_footprint.end());
+                    m_footprint.erase(std::unique(m_footprint.begin(), m_footprint.end()),
+                                      m_footprint.end());
+                }
             }
         }
         // Start at 1, so that 0 indicates no mtask ID.
@@ -254,6 +285,32 @@ public:
         // splice() is constant time
         m_mvertices.splice(m_mvertices.end(), otherp->m_mvertices);
         m_cost += otherp->m_cost;
+        if (!otherp->m_footprint.empty()) {
+            Footprint merged;
+            merged.reserve(m_footprint.size() + otherp->m_footprint.size());
+            std::set_union(m_footprint.begin(), m_footprint.end(), otherp->m_footprint.begin(),
+                           otherp->m_footprint.end(), std::back_inserter(merged));
+            m_footprint.swap(merged);
+            otherp->m_footprint.clear();
+        }
+    }
+    // Bytes of variables referenced by both this and the other mtask
+    uint64_t sharedBytes(const LogicMTask* otherp) const {
+        uint64_t bytes = 0;
+        auto ait = m_footprint.begin();
+        auto bit = otherp->m_footprint.begin();
+        while (ait != m_footprint.end() && bit != otherp->m_footprint.end()) {
+            if (ait->first < bit->first) {
+                ++ait;
+            } else if (bit->first < ait->first) {
+                ++bit;
+            } else {
+                bytes += ait->second;
+                ++ait;
+                ++bit;
+            }
+        }
+        return bytes;
     }
     const VxList* vertexListp() const override { return &m_mvertices; }
     static uint64_t incGeneration() {
@@ -406,6 +463,9 @@ struct MTaskIdLessThan final {
     }
 };
 
+// Footprint credit of a merge candidate that has not been scored yet
+constexpr uint32_t FOOTPRINT_UNSCORED = std::numeric_limits<uint32_t>::max();
+
 struct MergeCandidateKey {
     // Note: Structure layout chosen to minimize padding in PairingHeao<*>::Node
     uint64_t m_id;  // Unique ID part of edge score
@@ -473,6 +533,7 @@ class SiblingMC final : public MergeCandidate {
 
     V3ListEnt<SiblingMC*> m_aEnt;  // List entry for m_ap->aSiblingMCs()
     V3ListEnt<SiblingMC*> m_bEnt;  // List entry for m_bp->bSiblingMCs()
+    uint32_t m_footprintCredit = FOOTPRINT_UNSCORED;  // See footprintScore()
 
 public:
     // CONSTRUCTORS
@@ -501,6 +562,7 @@ public:
 
     LogicMTask* ap() const { return m_ap; }
     LogicMTask* bp() const { return m_bp; }
+    uint32_t& footprintCredit() { return m_footprintCredit; }
     bool mergeWouldCreateCycle() const {
         return (LogicMTask::pathExistsFrom(m_ap, m_bp, nullptr)
                 || LogicMTask::pathExistsFrom(m_bp, m_ap, nullptr));
@@ -519,6 +581,7 @@ class MTaskEdge final : public V3GraphEdge, public MergeCandidate {
     // This edge can be in 2 EdgeHeaps, one forward and one reverse. We allocate the heap nodes
     // directly within the edge as they are always required and this makes association cheap.
     std::array<EdgeHeap::Node, GraphWay::NUM_WAYS> m_edgeHeapNode;
+    uint32_t m_footprintCredit = FOOTPRINT_UNSCORED;  // See footprintScore()
 
 public:
     // CONSTRUCTORS
@@ -535,6 +598,7 @@ public:
     }
     LogicMTask* fromMTaskp() const { return static_cast<LogicMTask*>(fromp()); }
     LogicMTask* toMTaskp() const { return static_cast<LogicMTask*>(top()); }
+    uint32_t& footprintCredit() { return m_footprintCredit; }
     bool mergeWouldCreateCycle() const {
         return LogicMTask::pathExistsFrom(fromMTaskp(), toMTaskp(), this);
     }
@@ -698,17 +762,38 @@ bool MergeCandidate::mergeWouldCreateCycle() const {
                          : static_cast<const MTaskEdge*>(this)->mergeWouldCreateCycle();
 }
 
-static uint32_t siblingScore(const SiblingMC* sibsp) {
+static uint32_t footprintScore(uint32_t score, uint32_t& creditr, const LogicMTask* ap,
+                               const LogicMTask* bp) {
+    // Reduce a merge score by the data footprint the two mtasks share. Merging
+    // keeps that data in the cache of one thread, instead of bouncing it
+    // between cores. Each shared cache line is worth --threads-footprint-weight
+    // cost units of critical path.
+    const uint32_t weight = v3Global.opt.threadsFootprintWeight();
+    if (!weight) return score;
+    // The credit is fixed when the candidate is first scored. Footprints grow
+    // as mtasks merge, so recomputing it could lower the score of an existing
+    // candidate, but the scoreboard requires scores to only increase.
+    if (creditr == FOOTPRINT_UNSCORED) {
+        const uint64_t lines
+            = (ap->sharedBytes(bp) + VL_CACHE_LINE_BYTES - 1) / VL_CACHE_LINE_BYTES;
+        creditr = static_cast<uint32_t>(std::min<uint64_t>(lines * weight, FOOTPRINT_UNSCORED - 1));
+    }
+    return creditr >= score ? 0 : score - creditr;
+}
+
+static uint32_t siblingScore(SiblingMC* sibsp) {
     const LogicMTask* const ap = sibsp->ap();
     const LogicMTask* const bp = sibsp->bp();
     const uint32_t mergedCpCostFwd
         = std::max(ap->critPathCost(GraphWay::FORWARD), bp->critPathCost(GraphWay::FORWARD));
     const uint32_t mergedCpCostRev
         = std::max(ap->critPathCost(GraphWay::REVERSE), bp->critPathCost(GraphWay::REVERSE));
-    return mergedCpCostRev + mergedCpCostFwd + LogicMTask::stepCost(ap->cost() + bp->cost());
+    return footprintScore(
+        mergedCpCostRev + mergedCpCostFwd + LogicMTask::stepCost(ap->cost() + bp->cost()),
+        sibsp->footprintCredit(), ap, bp);
 }
 
-static uint32_t edgeScore(const MTaskEdge* edgep) {
+static uint32_t edgeScore(MTaskEdge* edgep) {
     // Score this edge. Lower is better. The score is the new local CP
     // length if we merge these mtasks.  ("Local" means the longest
     // critical path running through the merged node.)
@@ -718,17 +803,19 @@ static uint32_t edgeScore(const MTaskEdge* edgep) {
                                               top->critPathCostWithout(GraphWay::FORWARD, edgep));
     const uint32_t mergedCpCostRev = std::max(fromp->critPathCostWithout(GraphWay::REVERSE, edgep),
                                               top->critPathCost(GraphWay::REVERSE));
-    return mergedCpCostRev + mergedCpCostFwd + LogicMTask::stepCost(fromp->cost() + top->cost());
+    return footprintScore(
+        mergedCpCostRev + mergedCpCostFwd + LogicMTask::stepCost(fromp->cost() + top->cost()),
+        edgep->footprintCredit(), fromp, top);
 }
 
 void MergeCandidate::rescore() {
-    if (const SiblingMC* const sibp = toSiblingMC()) {
+    if (SiblingMC* const sibp = toSiblingMC()) {
         m_key.m_score = siblingScore(sibp);
     } else {
         // The '1 +' favors merging a SiblingMC over an otherwise-
         // equal-scoring MTaskEdge. The comment on selfTest() talks
         // about why.
-        m_key.m_score = 1 + edgeScore(static_cast<const MTaskEdge*>(this));
+        m_key.m_score = 1 + edgeScore(static_cast<MTaskEdge*>(this));
     }
 }
 
@@ -1232,6 +1319,104 @@ static void partRedirectEdgesFrom(V3Graph* graphp, LogicMTask* recipientp, Logic
     VL_DO_DANGLING(donorp->unlinkDelete(graphp), donorp);
 }
 
+//######################################################################
+// PartChainCoarsen
+
+// Merge chains of mtasks, where each mtask has a single successor, and that
+// successor has no other predecessor. Such merges neither lengthen the
+// critical path nor remove any parallelism, so PartContraction would make
+// them too, but each of its merges costs a scoreboard update and critical
+// path propagation. Merging the chains up front lets PartContraction work
+// on a much smaller graph. Finding the chains does not modify the graph,
+// so it is done in parallel on V3ThreadPool, the merges are then serial.
+class PartChainCoarsen final {
+    // TYPES
+    using Chain = std::vector<LogicMTask*>;
+    using Chains = std::vector<Chain>;
+
+    // MEMBERS
+    V3Graph* const m_mtasksp;  // Mtask graph
+    const uint64_t m_costLimit;  // Maximum cost of a coarsened mtask
+    size_t m_merges = 0;  // Number of merges made
+
+    // METHODS
+    // The mtask to merge next into vxp, or nullptr if vxp ends its chain
+    static LogicMTask* chainNext(const V3GraphVertex* vxp) {
+        const V3GraphEdge* const edgep = vxp->outBeginp();
+        if (!edgep || edgep->outNextp()) return nullptr;
+        if (edgep->top()->inBeginp()->inNextp()) return nullptr;
+        return static_cast<LogicMTask*>(edgep->top());
+    }
+    static bool isChainHead(const V3GraphVertex* vxp) {
+        const V3GraphEdge* const edgep = vxp->inBeginp();
+        return !edgep || chainNext(edgep->fromp()) != vxp;
+    }
+
+    // Split the chains starting at the given heads into runs under the cost limit
+    Chains findChains(const std::vector<LogicMTask*>& headps, size_t begin, size_t end) const {
+        Chains chains;
+        for (size_t i = begin; i < end; ++i) {
+            Chain chain;
+            uint64_t cost = 0;
+            for (LogicMTask* mtaskp = headps[i]; mtaskp; mtaskp = chainNext(mtaskp)) {
+                if (!chain.empty() && cost + mtaskp->cost() > m_costLimit) {
+                    if (chain.size() > 1) chains.push_back(std::move(chain));
+                    chain.clear();
+                    cost = 0;
+                }
+                chain.push_back(mtaskp);
+                cost += mtaskp->cost();
+            }
+            if (chain.size() > 1) chains.push_back(std::move(chain));
+        }
+        return chains;
+    }
+
+    void mergeChain(const Chain& chain) {
+        LogicMTask* const recipientp = chain.front();
+        for (auto it = chain.begin() + 1; it != chain.end(); ++it) {
+            LogicMTask* const donorp = *it;
+            // The recipient's only successor is the donor, remove the connecting edge
+            MTaskEdge* const edgep = static_cast<MTaskEdge*>(recipientp->outBeginp());
+            UASSERT_OBJ(edgep && !edgep->outNextp() && edgep->toMTaskp() == donorp, recipientp,
+                        "Chain should be connected by a single edge");
+            recipientp->removeRelativeMTask(donorp);
+            recipientp->removeRelativeEdge<GraphWay::FORWARD>(edgep);
+            donorp->removeRelativeEdge<GraphWay::REVERSE>(edgep);
+            VL_DO_DANGLING(edgep->unlinkDelete(), edgep);
+            recipientp->moveAllVerticesFrom(donorp);
+            partRedirectEdgesFrom(m_mtasksp, recipientp, donorp, nullptr);
+            ++m_merges;
+        }
+    }
+
+public:
+    // CONSTRUCTORS
+    PartChainCoarsen(V3Graph* mtasksp, uint32_t cpLimit)
+        : m_mtasksp{mtasksp}
+        , m_costLimit{std::max<uint64_t>(cpLimit / PART_COARSEN_COST_DIVISOR, 1)} {}
+
+    // METHODS
+    size_t go() {
+        std::vector<LogicMTask*> headps;
+        for (V3GraphVertex* vxp = m_mtasksp->verticesBeginp(); vxp; vxp = vxp->verticesNextp()) {
+            if (isChainHead(vxp)) headps.push_back(static_cast<LogicMTask*>(vxp));
+        }
+
+        std::list<std::future<Chains>> futures;
+        for (size_t begin = 0; begin < headps.size(); begin += PART_COARSEN_HEADS_PER_JOB) {
+            const size_t end = std::min(begin + PART_COARSEN_HEADS_PER_JOB, headps.size());
+            futures.push_back(V3ThreadPool::s().enqueue(
+                [this, &headps, begin, end]() { return findChains(headps, begin, end); }));
+        }
+        // Merge in the order of the heads, so the result is deterministic
+        for (const Chains& chains : V3ThreadPool::waitForFutures(futures)) {
+            for (const Chain& chain : chains) mergeChain(chain);
+        }
+        return m_merges;
+    }
+};
+
 //######################################################################
 // PartContraction
 
@@ -1251,6 +1436,7 @@ private:
     uint32_t m_scoreLimit;  // Sloppy score allowed when picking merges
     uint32_t m_scoreLimitBeforeRescore = 0xffffffff;  // Next score rescore at
     unsigned m_mergesSinceRescore = 0;  // Merges since last rescore
+    size_t m_footprintMerges = 0;  // Merges credited for data footprint the mtasks share
     const bool m_slowAsserts;  // Take extra time to validate algorithm
     MergeCandidateScoreboard m_sb;  // Scoreboard
 
@@ -1424,6 +1610,10 @@ public:
             // Finally merge this candidate.
             contract(mergeCanp);
         }
+
+        if (v3Global.opt.threadsFootprintWeight()) {
+            V3Stats::addStatSum("MTask graph, footprint merges", m_footprintMerges);
+        }
     }
 
 private:
@@ -1500,6 +1690,9 @@ private:
             top = mergeSibsp->ap();
             fromp = mergeSibsp->bp();
         }
+        const uint32_t credit
+            = mergeEdgep ? mergeEdgep->footprintCredit() : mergeSibsp->footprintCredit();
+        if (credit && credit != FOOTPRINT_UNSCORED) ++m_footprintMerges;
 
         // Merge the smaller mtask into the larger mtask.  If one of them
         // is much larger, this will save time in partRedirectEdgesFrom().
@@ -2749,6 +2942,29 @@ void V3Partition::go(V3Graph* mtasksp) {
         hashGraphDebug(mtasksp, "mtasksp after fixDataHazards()");
     }
 
+    const int targetParFactor = v3Global.opt.threads();
+    if (targetParFactor < 2) v3fatalSrc("We should not reach V3Partition when --threads <= 1");
+
+    // Set cpLimit to roughly totalGraphCost / nThreads
+    //
+    // Actually set it a bit lower, by a hardcoded fudge factor. This
+    // results in more smaller mtasks, which helps reduce fragmentation
+    // when scheduling them.
+    const unsigned fudgeNumerator = 3;
+    const unsigned fudgeDenominator = 5;
+    const uint32_t cpLimit
+        = ((totalGraphCost * fudgeNumerator) / (targetParFactor * fudgeDenominator));
+    UINFO(4, "V3Partition set cpLimit = " << cpLimit << endl);
+
+    // Cheaply merge chains first, so the precise contraction has less to do.
+    // Chain merges keep the graph ranked, so this may precede orderPreRanked().
+    if (v3Global.opt.threadsCoarsen() && v3Global.opt.threadsFastContraction()) {
+        const size_t merges = PartChainCoarsen{mtasksp, cpLimit}.go();
+        V3Stats::addStatSum("MTask graph, chain merges", merges);
+        V3Partition::debugMTaskGraphStats(mtasksp, "coarsen");
+        hashGraphDebug(mtasksp, "mtasksp after PartChainCoarsen");
+    }
+
     // Setup the critical path into and out of each node.
     partInitCriticalPaths(mtasksp);
     hashGraphDebug(mtasksp, "after partInitCriticalPaths()");
@@ -2766,20 +2982,6 @@ void V3Partition::go(V3Graph* mtasksp) {
     // remove this later if it doesn't really help.
     mtasksp->orderPreRanked();
 
-    const int targetParFactor = v3Global.opt.threads();
-    if (targetParFactor < 2) v3fatalSrc("We should not reach V3Partition when --threads <= 1");
-
-    // Set cpLimit to roughly totalGraphCost / nThreads
-    //
-    // Actually set it a bit lower, by a hardcoded fudge factor. This
-    // results in more smaller mtasks, which helps reduce fragmentation
-    // when scheduling them.
-    const unsigned fudgeNumerator = 3;
-    const unsigned fudgeDenominator = 5;
-    const uint32_t cpLimit
-        = ((totalGraphCost * fudgeNumerator) / (targetParFactor * fudgeDenominator));
-    UINFO(4, "V3Partition set cpLimit = " << cpLimit << endl);
-
     // Merge MTask nodes together, repeatedly, until the CP budget is
     // reached.  Coarsens the graph, usually by several orders of
     // magnitude.
@@ -3041,30 +3243,25 @@ static void finalizeCosts(V3Graph* execMTaskGraphp) {
     }
 }
 
-static void addMTaskToFunction(const ThreadSchedule& schedule, const uint32_t threadId,
-                               AstCFunc* funcp, const ExecMTask* mtaskp) {
+static void addMTaskStateVar(const string& name, uint32_t nDependencies) {
     AstNodeModule* const modp = v3Global.rootp()->topModulep();
     FileLine* const fl = modp->fileline();
+    AstBasicDType* const mtaskStateDtypep
+        = v3Global.rootp()->typeTablep()->findBasicDType(fl, VBasicDTypeKwd::MTASKSTATE);
+    AstVar* const varp = new AstVar{fl, VVarType::MODULETEMP, name, mtaskStateDtypep};
+    varp->valuep(new AstConst{fl, nDependencies});
+    varp->protect(false);  // Do not protect as we still have references in AstText
+    modp->addStmtsp(varp);
+}
+
+static void addMTaskBody(AstCFunc* funcp, const ExecMTask* mtaskp) {
+    FileLine* const fl = v3Global.rootp()->topModulep()->fileline();
 
     // Helper function to make the code a bit more legible
     const auto addStrStmt = [=](const string& stmt) -> void {  //
         funcp->addStmtsp(new AstCStmt{fl, stmt});
     };
 
-    if (const uint32_t nDependencies = schedule.crossThreadDependencies(mtaskp)) {
-        // This mtask has dependencies executed on another thread, so it may block. Create the task
-        // state variable and wait to be notified.
-        const string name = "__Vm_mtaskstate_" + cvtToStr(mtaskp->id());
-        AstBasicDType* const mtaskStateDtypep
-            = v3Global.rootp()->typeTablep()->findBasicDType(fl, VBasicDTypeKwd::MTASKSTATE);
-        AstVar* const varp = new AstVar{fl, VVarType::MODULETEMP, name, mtaskStateDtypep};
-        varp->valuep(new AstConst{fl, nDependencies});
-        varp->protect(false);  // Do not protect as we still have references in AstText
-        modp->addStmtsp(varp);
-        // For now, reference is still via text bashing
-        addStrStmt("vlSelf->" + name + +".waitUntilUpstreamDone(even_cycle);\n");
-    }
-
     if (v3Global.opt.profExec()) {
         const string& id = cvtToStr(mtaskp->id());
         const string& predictStart = cvtToStr(mtaskp->predictStart());
@@ -3097,6 +3294,27 @@ static void addMTaskToFunction(const ThreadSchedule& schedule, const uint32_t th
         addStrStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).mtaskEnd(" + id + ", " + predictConst
                    + ");\n");
     }
+}
+
+static void addMTaskToFunction(const ThreadSchedule& schedule, const uint32_t threadId,
+                               AstCFunc* funcp, const ExecMTask* mtaskp) {
+    FileLine* const fl = v3Global.rootp()->topModulep()->fileline();
+
+    // Helper function to make the code a bit more legible
+    const auto addStrStmt = [=](const string& stmt) -> void {  //
+        funcp->addStmtsp(new AstCStmt{fl, stmt});
+    };
+
+    if (const uint32_t nDependencies = schedule.crossThreadDependencies(mtaskp)) {
+        // This mtask has dependencies executed on another thread, so it may block. Create the task
+        // state variable and wait to be notified.
+        const string name = "__Vm_mtaskstate_" + cvtToStr(mtaskp->id());
+        addMTaskStateVar(name, nDependencies);
+        // For now, reference is still via text bashing
+        addStrStmt("vlSelf->" + name + +".waitUntilUpstreamDone(even_cycle);\n");
+    }
+
+    addMTaskBody(funcp, mtaskp);
 
     // For any dependent mtask that's on another thread, signal one dependency completion.
     for (V3GraphEdge* edgep = mtaskp->outBeginp(); edgep; edgep = edgep->outNextp()) {
@@ -3143,13 +3361,7 @@ static const std::vector<AstCFunc*> createThreadFunctions(const ThreadSchedule&
     }
 
     // Create the fake "final" mtask state variable
-    AstBasicDType* const mtaskStateDtypep
-        = v3Global.rootp()->typeTablep()->findBasicDType(fl, VBasicDTypeKwd::MTASKSTATE);
-    AstVar* const varp
-        = new AstVar{fl, VVarType::MODULETEMP, "__Vm_mtaskstate_final__" + tag, mtaskStateDtypep};
-    varp->valuep(new AstConst(fl, funcps.size()));
-    varp->protect(false);  // Do not protect as we still have references in AstText
-    modp->addStmtsp(varp);
+    addMTaskStateVar("__Vm_mtaskstate_final__" + tag, funcps.size());
 
     return funcps;
 }
@@ -3175,10 +3387,17 @@ static void addThreadStartToExecGraph(AstExecGraph* const execGraphp,
     for (uint32_t i = 0; i <= last; ++i) {
         AstCFunc* const funcp = funcps.at(i);
         if (i != last) {
-            // The first N-1 will run on the thread pool.
-            addTextStmt("vlSymsp->__Vm_threadPoolp->workerp(" + cvtToStr(i) + ")->addTask(");
+            // The first N-1 will run on the thread pool. The guard keeps them
+            // queued together if the pool's threads are shared with other contexts.
+            if (i == 0) {
+                addStrStmt("{\n");
+                addStrStmt("const VlThreadPool::DispatchGuard __Vdispatch{"
+                           "*vlSymsp->__Vm_threadPoolp};\n");
+            }
+            addTextStmt("vlSymsp->__Vm_threadPoolp->addTask(" + cvtToStr(i) + ", ");
             execGraphp->addStmtsp(new AstAddrOfCFunc{fl, funcp});
             addTextStmt(", vlSelf, vlSymsp->__Vm_even_cycle__" + tag + ");\n");
+            if (i == last - 1) addStrStmt("}\n");
         } else {
             // The last will run on the main thread.
             AstCCall* const callp = new AstCCall{fl, funcp};
@@ -3193,14 +3412,108 @@ static void addThreadStartToExecGraph(AstExecGraph* const execGraphp,
                + ".waitUntilUpstreamDone(vlSymsp->__Vm_even_cycle__" + tag + ");\n");
 }
 
+static void implementExecGraphDynamic(AstExecGraph* const execGraphp) {
+    // With --threads-schedule dynamic, each mtask becomes its own function. Ready
+    // mtasks are pushed to the thread pool's work stealing deques, and whichever
+    // thread completes the last upstream dependency of an mtask makes it ready.
+    AstNodeModule* const modp = v3Global.rootp()->topModulep();
+    FileLine* const fl = modp->fileline();
+    const string& tag = execGraphp->name();
+    V3Graph* const depGraphp = execGraphp->depGraphp();
+
+    // Create the functions first, so successors can refer to them
+    std::unordered_map<const ExecMTask*, AstCFunc*> funcps;
+    for (V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp; vxp = vxp->verticesNextp()) {
+        const ExecMTask* const mtaskp = static_cast<ExecMTask*>(vxp);
+        AstCFunc* const funcp = new AstCFunc{fl, mtaskp->cFuncName(), nullptr, "void"};
+        modp->addStmtsp(funcp);
+        funcps.emplace(mtaskp, funcp);
+        funcp->isStatic(true);  // Uses void self pointer, so static and hand rolled
+        funcp->isLoose(true);
+        funcp->entryPoint(true);
+        funcp->argTypes("void* voidSelf, bool even_cycle");
+        funcp->addStmtsp(new AstCStmt{fl, EmitCBase::voidSelfAssign(modp)});
+        funcp->addStmtsp(new AstCStmt{fl, EmitCBase::symClassAssign()});
+    }
+
+    // Statement pushing 'funcp' to the thread pool for execution
+    const auto pushReadyStmt
+        = [=](const string& prefix, AstCFunc* funcp, const string& evenCycle) -> AstCStmt* {
+        const string text = prefix + "vlSymsp->__Vm_threadPoolp->pushReady(";
+        AstCStmt* const stmtp = new AstCStmt{fl, new AstText{fl, text, /* tracking: */ true}};
+        stmtp->addExprsp(new AstAddrOfCFunc{fl, funcp});
+        stmtp->addExprsp(new AstText{fl, ", vlSelf, " + evenCycle + ");\n", true});
+        return stmtp;
+    };
+
+    std::vector<AstCFunc*> rootps;
+    uint32_t nSinks = 0;
+    for (V3GraphVertex* vxp = depGraphp->verticesBeginp(); vxp; vxp = vxp->verticesNextp()) {
+        const ExecMTask* const mtaskp = static_cast<ExecMTask*>(vxp);
+        AstCFunc* const funcp = funcps.at(mtaskp);
+
+        // Every mtask with upstream dependencies counts them, regardless of thread
+        uint32_t nDependencies = 0;
+        for (V3GraphEdge* edgep = mtaskp->inBeginp(); edgep; edgep = edgep->inNextp()) {
+            ++nDependencies;
+        }
+        if (nDependencies) {
+            addMTaskStateVar("__Vm_mtaskstate_" + cvtToStr(mtaskp->id()), nDependencies);
+        } else {
+            rootps.push_back(funcp);
+        }
+
+        addMTaskBody(funcp, mtaskp);
+
+        // Signal each dependent mtask, and push it when this was its last dependency
+        for (V3GraphEdge* edgep = mtaskp->outBeginp(); edgep; edgep = edgep->outNextp()) {
+            const ExecMTask* const nextp = static_cast<ExecMTask*>(edgep->top());
+            funcp->addStmtsp(pushReadyStmt("if (vlSelf->__Vm_mtaskstate_" + cvtToStr(nextp->id())
+                                               + ".signalUpstreamDone(even_cycle)) ",
+                                           funcps.at(nextp), "even_cycle"));
+        }
+        // Unblock the fake "final" mtask when a sink of the graph is finished
+        if (mtaskp->outEmpty()) {
+            ++nSinks;
+            funcp->addStmtsp(new AstCStmt{fl, "vlSelf->__Vm_mtaskstate_final__" + tag
+                                                  + ".signalUpstreamDone(even_cycle);\n"});
+        }
+    }
+    UASSERT(!rootps.empty() && nSinks, "Non-empty ExecGraph has no roots or sinks?");
+    addMTaskStateVar("__Vm_mtaskstate_final__" + tag, nSinks);
+
+    // Start the roots and execute at the point this AstExecGraph is located in the tree.
+    const string evenCycle = "vlSymsp->__Vm_even_cycle__" + tag;
+    execGraphp->addStmtsp(new AstCStmt{fl, evenCycle + " = !" + evenCycle + ";\n"});
+    for (AstCFunc* const funcp : rootps) {
+        execGraphp->addStmtsp(pushReadyStmt("", funcp, evenCycle));
+    }
+    execGraphp->addStmtsp(new AstCStmt{
+        fl, "vlSymsp->__Vm_threadPoolp->executeDynamic(vlSelf->__Vm_mtaskstate_final__" + tag
+                + ", " + evenCycle + ");\n"});
+    execGraphp->addStmtsp(new AstCStmt{fl, "Verilated::mtaskId(0);\n"});
+}
+
 static void implementExecGraph(AstExecGraph* const execGraphp) {
     // Nothing to be done if there are no MTasks in the graph at all.
     if (execGraphp->depGraphp()->empty()) return;
 
+    if (v3Global.opt.threadsDynamic()) {
+        implementExecGraphDynamic(execGraphp);
+        return;
+    }
+
     // Schedule the mtasks: statically associate each mtask with a thread,
     // and determine the order in which each thread will runs its mtasks.
     const ThreadSchedule& schedule = PartPackMTasks{}.pack(*execGraphp->depGraphp());
 
+    // Remember the assignment, V3VariableOrder lays out variables by thread
+    for (V3GraphVertex* vxp = execGraphp->depGraphp()->verticesBeginp(); vxp;
+         vxp = vxp->verticesNextp()) {
+        ExecMTask* const mtaskp = static_cast<ExecMTask*>(vxp);
+        mtaskp->threadId(schedule.threadId(mtaskp));
+    }
+
     // Create a function to be run by each thread. Note this moves all AstMTaskBody nodes form the
     // AstExecGrap into the AstCFunc created
     const std::vector<AstCFunc*>& funcps = createThreadFunctions(schedule, execGraphp->name());
@@ -3226,6 +3539,65 @@ void V3Partition::finalize(AstNetlist* netlistp) {
     });
 }
 
+// Report partitioner runtime on a generated graph, for --debug-partition-benchmark
+static void partitionBenchmarkOne(unsigned nMTasks, bool fast) {
+    // Each mtask depends on the previous one, or on one or two of the recent
+    // ones, which gives a mix of chains, forks and joins.
+    V3Graph mtasks;
+    std::vector<LogicMTask*> mtaskps;
+    mtaskps.reserve(nMTasks);
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    const auto random = [&state](uint64_t n) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state % n;
+    };
+    uint64_t totalCost = 0;
+    for (unsigned i = 0; i < nMTasks; ++i) {
+        LogicMTask* const mtaskp = new LogicMTask{&mtasks, nullptr};
+        mtaskp->setCost(1 + random(20));
+        totalCost += mtaskp->cost();
+        if (i) {
+            const uint64_t shape = random(4);
+            const unsigned nDeps = shape < 2 ? 0 : shape - 1;
+            if (!nDeps) new MTaskEdge{&mtasks, mtaskps.back(), mtaskp, 1};
+            for (unsigned dep = 0; dep < nDeps; ++dep) {
+                LogicMTask* const fromp = mtaskps[i - 1 - random(std::min(i, 64U))];
+                if (!fromp->hasRelativeMTask(mtaskp)) new MTaskEdge{&mtasks, fromp, mtaskp, 1};
+            }
+        }
+        mtaskps.push_back(mtaskp);
+    }
+    // As if for 8 threads, see V3Partition::go
+    const uint32_t cpLimit = static_cast<uint32_t>((totalCost * 3) / (8 * 5));
+
+    const uint64_t startUsecs = V3Os::timeUsecs();
+    const size_t merges = fast ? PartChainCoarsen{&mtasks, cpLimit}.go() : 0;
+    const uint64_t coarsenUsecs = V3Os::timeUsecs();
+    partInitCriticalPaths(&mtasks);
+    PartContraction{&mtasks, cpLimit, false}.go();
+    const uint64_t endUsecs = V3Os::timeUsecs();
+
+    PartParallelismEst check{&mtasks};
+    check.traverse();
+    UINFO(0, "Partition benchmark: mtasks " << nMTasks << ", contraction "
+                                            << (fast ? "fast" : "precise") << ", chain merges "
+                                            << merges << ", final mtasks " << check.vertexCount()
+                                            << ", critical path " << check.longestCritPathCost()
+                                            << ", coarsen usecs " << (coarsenUsecs - startUsecs)
+                                            << ", total usecs " << (endUsecs - startUsecs)
+                                            << endl);
+}
+
+void V3Partition::benchmark(unsigned maxMTasks) {
+    UINFO(2, __FUNCTION__ << ": " << endl);
+    for (unsigned nMTasks = 1000; nMTasks <= maxMTasks; nMTasks *= 10) {
+        partitionBenchmarkOne(nMTasks, false);
+        partitionBenchmarkOne(nMTasks, true);
+    }
+}
+
 void V3Partition::selfTest() {
     UINFO(2, __FUNCTION__ << ": " << endl);
     PartPropagateCpSelfTest::selfTest();
@@ -56,6 +56,9 @@ public:
     static void selfTest();
     static void selfTestNormalizeCosts();
 
+    // Report partitioner runtime on generated graphs of up to maxMTasks
+    static void benchmark(unsigned maxMTasks);
+
     // Print out a hash of the shape of graphp.  Only needed to debug the
     // origin of some nondeterminism; otherwise this is pretty useless.
     static void hashGraphDebug(const V3Graph* graphp, const char* debugName);
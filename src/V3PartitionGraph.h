@@ -64,6 +64,7 @@ private:
                           // abstract time units as priority().
     uint64_t m_predictStart = 0;  // Predicted start time of task
     uint64_t m_profilerId = 0;  // VerilatedCounter number for profiling
+    uint32_t m_threadId = 0xffffffff;  // Thread assigned by static scheduling, ~0 if none
     VL_UNCOPYABLE(ExecMTask);
 
 public:
@@ -81,6 +82,8 @@ public:
     uint64_t predictStart() const { return m_predictStart; }
     void profilerId(uint64_t id) { m_profilerId = id; }
     uint64_t profilerId() const { return m_profilerId; }
+    void threadId(uint32_t id) { m_threadId = id; }
+    uint32_t threadId() const { return m_threadId; }
     string cFuncName() const {
         // If this MTask maps to a C function, this should be the name
         return std::string{"__Vmtask"} + "__" + cvtToStr(m_id);
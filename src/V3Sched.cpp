@@ -26,6 +26,9 @@
 //    (including combinationally generated signals) are computed within the act region.
 //  - Replicate combinational logic
 //  - Create input combinational logic loop
+//  - With -fsched-single-clock, if the design is clocked by a single top level input edge,
+//    create the 'nba' region and a '_eval' that calls it on the clock edge, without any
+//    triggers or evaluation loops, and skip the remaining steps
 //  - Create the pre/act/nba triggers
 //  - Create the 'act' region evaluation function
 //  - Create the 'nba' region evaluation function
@@ -400,6 +403,17 @@ AstSenTree* createTriggerSenTree(AstNetlist* netlistp, AstVarScope* const vscp,
     return resultp;
 }
 
+// Create an AstSenTree that is always true, for logic that is run unconditionally in its region
+AstSenTree* createAlwaysSenTree(AstNetlist* netlistp) {
+    AstTopScope* const topScopep = netlistp->topScopep();
+    FileLine* const flp = topScopep->fileline();
+    AstNodeExpr* const termp = new AstConst{flp, AstConst::BitTrue{}};
+    AstSenItem* const senItemp = new AstSenItem{flp, VEdgeType::ET_TRUE, termp};
+    AstSenTree* const resultp = new AstSenTree{flp, senItemp};
+    topScopep->addSenTreesp(resultp);
+    return resultp;
+}
+
 //============================================================================
 // Utility for extra trigger allocation
 
@@ -717,9 +731,11 @@ void createSettle(AstNetlist* netlistp, AstCFunc* const initFuncp, SenExprBuilde
     AstSenTree* const inputChanged
         = createTriggerSenTree(netlistp, trig.m_vscp, firstIterationTrigger);
 
-    // Create and the body function
+    // Create and the body function. This is ordered in parallel if requested, so the settle loop
+    // of large designs runs on the thread pool like the 'nba' region.
+    const bool parallel = v3Global.opt.mtasks() && v3Global.opt.fSchedParallelSettle();
     AstCFunc* const stlFuncp = V3Order::order(
-        netlistp, {&comb, &hybrid}, trigToSen, "stl", false, true,
+        netlistp, {&comb, &hybrid}, trigToSen, "stl", parallel, true,
         [=](const AstVarScope*, std::vector<AstSenTree*>& out) { out.push_back(inputChanged); });
     splitCheck(stlFuncp);
 
@@ -748,7 +764,8 @@ void createSettle(AstNetlist* netlistp, AstCFunc* const initFuncp, SenExprBuilde
 // Order the replicated combinational logic to create the 'ico' region
 
 AstNode* createInputCombLoop(AstNetlist* netlistp, AstCFunc* const initFuncp,
-                             SenExprBuilder& senExprBuilder, LogicByScope& logic) {
+                             SenExprBuilder& senExprBuilder, LogicByScope& logic,
+                             bool singleClock) {
     // Nothing to do if no combinational logic is sensitive to top level inputs
     if (logic.empty()) return nullptr;
 
@@ -766,6 +783,25 @@ AstNode* createInputCombLoop(AstNetlist* netlistp, AstCFunc* const initFuncp,
         });
     }
 
+    // With a single clock, nothing but the top level inputs can trigger this logic, so a
+    // single evaluation without triggers is sufficient (see 'singleClockSenTree')
+    if (singleClock) {
+        AstSenTree* const inputChanged = createAlwaysSenTree(netlistp);
+        const std::unordered_map<const AstSenItem*, const AstSenTree*> trigToSen;
+        AstCFunc* const icoFuncp
+            = V3Order::order(netlistp, {&logic}, trigToSen, "ico", false, false,
+                             [=](const AstVarScope* vscp, std::vector<AstSenTree*>& out) {
+                                 AstVar* const varp = vscp->varp();
+                                 if (varp->isPrimaryInish() || varp->isSigUserRWPublic()) {
+                                     out.push_back(inputChanged);
+                                 }
+                             });
+        splitCheck(icoFuncp);
+        AstCCall* const callp = new AstCCall{icoFuncp->fileline(), icoFuncp};
+        callp->dtypeSetVoid();
+        return callp->makeStmt();
+    }
+
     // We have some extra trigger denoting external conditions
     AstVarScope* const dpiExportTriggerVscp = netlistp->dpiExportTriggerp();
 
@@ -1006,6 +1042,201 @@ void createEval(AstNetlist* netlistp,  //
     }
 }
 
+//============================================================================
+// Simplified scheduling of designs with a single clock
+
+// Returns the AstSenTree of the only clock of the design, if the design is simple enough to be
+// evaluated without trigger vectors and convergence loops, otherwise returns nullptr. This
+// requires all clocked logic to be sensitive to a single edge of a top level input, and no
+// logic being able to re-trigger evaluation within a time step (computed clocks, events,
+// timing controls, DPI exports, observed/reactive regions, or combinational cycles).
+const AstSenTree* singleClockSenTree(AstNetlist* netlistp, const LogicClasses& logicClasses,
+                                     const LogicRegions& logicRegions,
+                                     const LogicReplicas& logicReplicas,
+                                     const TimingKit& timingKit) {
+    if (!v3Global.opt.fSchedSingleClock()) return nullptr;
+    if (v3Global.opt.xInitialEdge() || v3Global.hasEvents()) return nullptr;
+    if (netlistp->dpiExportTriggerp()) return nullptr;
+    if (!timingKit.m_lbs.empty() || timingKit.m_postUpdates) return nullptr;
+    if (!logicClasses.m_hybrid.empty()) return nullptr;
+    if (!logicClasses.m_observed.empty() || !logicClasses.m_reactive.empty()) return nullptr;
+    if (!logicRegions.m_pre.empty() || !logicRegions.m_act.empty()) return nullptr;
+    if (!logicReplicas.m_act.empty()) return nullptr;
+
+    const auto& senTreeps = getSenTreesUsedBy({&logicRegions.m_nba});
+    if (senTreeps.size() != 1) return nullptr;
+    const AstSenTree* const senTreep = senTreeps.front();
+    const AstSenItem* const senItemp = senTreep->sensesp();
+    if (senItemp->nextp()) return nullptr;
+    if (senItemp->edgeType() != VEdgeType::ET_POSEDGE
+        && senItemp->edgeType() != VEdgeType::ET_NEGEDGE) {
+        return nullptr;
+    }
+    const AstVarRef* const refp = VN_CAST(senItemp->sensp(), VarRef);
+    if (!refp || refp->width() != 1) return nullptr;
+    if (!refp->varScopep()->scopep()->isTop()) return nullptr;
+    if (!refp->varp()->isPrimaryInish()) return nullptr;
+    return senTreep;
+}
+
+// Create the 'nba' region and the top level _eval function for a design with a single clock.
+// The 'nba' region is evaluated at most once, when the clock edge is detected. Returns the
+// 'nba' region evaluation function.
+AstCFunc* createSingleClockEval(AstNetlist* netlistp, AstCFunc* const initFuncp,
+                                SenExprBuilder& senExprBuilder, AstNode* icoLoopp,
+                                const AstSenTree* clockSenTreep, LogicRegions& logicRegions,
+                                LogicReplicas& logicReplicas, AstCFunc* postponedFuncp) {
+    AstScope* const scopeTopp = netlistp->topScopep()->scopep();
+    FileLine* const flp = netlistp->fileline();
+
+    // Create the 'nba' region evaluation function. All clocked logic runs unconditionally.
+    std::unordered_map<const AstSenTree*, AstSenTree*> trigMap;
+    trigMap.emplace(clockSenTreep, createAlwaysSenTree(netlistp));
+    remapSensitivities(logicRegions.m_nba, trigMap);
+    remapSensitivities(logicReplicas.m_nba, trigMap);
+    std::unordered_map<const AstSenItem*, const AstSenTree*> trigToSen;
+    invertAndMergeSenTreeMap(trigToSen, trigMap);
+    AstCFunc* const nbaFuncp = V3Order::order(
+        netlistp, {&logicRegions.m_nba, &logicReplicas.m_nba}, trigToSen, "nba",
+        v3Global.opt.mtasks(), false, [](const AstVarScope*, std::vector<AstSenTree*>&) {});
+    splitCheck(nbaFuncp);
+    netlistp->evalNbap(nbaFuncp);  // Remember for V3LifePost
+
+    AstCFunc* const funcp = makeTopFunction(netlistp, "_eval", false);
+    netlistp->evalp(funcp);
+
+    // Detect the clock edge. This must follow the 'ico' evaluation, as in the general case.
+    AstNodeExpr* const edgep = senExprBuilder.build(clockSenTreep).first;
+    for (AstVar* const varp : senExprBuilder.getAndClearLocals()) funcp->addStmtsp(varp);
+    for (AstNodeStmt* const nodep : senExprBuilder.getAndClearInits()) {
+        initFuncp->addStmtsp(nodep);
+    }
+    UASSERT_OBJ(senExprBuilder.getAndClearPreUpdates().empty(), clockSenTreep,
+                "Clock edge should not need pre updates");
+    if (icoLoopp) funcp->addStmtsp(icoLoopp);
+    AstVarScope* const edgeVscp = scopeTopp->createTemp("__VclockEdge", 1);
+    edgeVscp->varp()->noReset(true);
+    funcp->addStmtsp(new AstAssign{flp, new AstVarRef{flp, edgeVscp, VAccess::WRITE}, edgep});
+    for (AstNodeStmt* const nodep : senExprBuilder.getAndClearPostUpdates()) {
+        funcp->addStmtsp(nodep);
+    }
+
+    // Evaluate the 'nba' region on the clock edge
+    {
+        AstIf* const ifp = new AstIf{flp, new AstVarRef{flp, edgeVscp, VAccess::READ}};
+        AstCCall* const callp = new AstCCall{flp, nbaFuncp};
+        callp->dtypeSetVoid();
+        ifp->addThensp(callp->makeStmt());
+        funcp->addStmtsp(ifp);
+    }
+
+    // Add the Postponed eval call
+    if (postponedFuncp) {
+        AstCCall* const callp = new AstCCall{flp, postponedFuncp};
+        callp->dtypeSetVoid();
+        funcp->addStmtsp(callp->makeStmt());
+    }
+
+    return nbaFuncp;
+}
+
+//============================================================================
+// Skipping evaluation when no inputs changed
+
+// Can the value of this variable be compared and copied cheaply
+bool isSnapshotVar(const AstVarScope* vscp) {
+    const AstVar* const varp = vscp->varp();
+    if (varp->isSc()) return false;
+    const AstNodeDType* const dtypep = vscp->dtypep()->skipRefp();
+    if (const AstBasicDType* const basicp = VN_CAST(dtypep, BasicDType)) {
+        return !basicp->isOpaque() || basicp->isDouble() || basicp->isString();
+    }
+    return VN_IS(dtypep, PackArrayDType)
+           || (VN_IS(dtypep, NodeUOrStructDType) && VN_AS(dtypep, NodeUOrStructDType)->packed());
+}
+
+// Wrap the body of '_eval' in a check that compares the values the application can write (the
+// top level inputs and public writable signals) against a snapshot taken at the end of the
+// previous evaluation. If nothing changed, no delay is due and no DPI export was called, the
+// evaluation is skipped, and counted in a variable the model exposes as 'evalsSkipped()'.
+void createEvalSkip(AstNetlist* netlistp, AstCFunc* const initFuncp) {
+    AstCFunc* const evalp = netlistp->evalp();
+    AstScope* const scopeTopp = netlistp->topScopep()->scopep();
+    FileLine* const flp = netlistp->fileline();
+
+    // Gather the variables the application can change between evaluations
+    std::vector<AstVarScope*> inputs;
+    AstVarScope* dlySchedVscp = nullptr;
+    bool supported = true;
+    netlistp->foreach([&](AstVarScope* vscp) {
+        const AstVar* const varp = vscp->varp();
+        if (varp == netlistp->delaySchedulerp()) dlySchedVscp = vscp;
+        // Forced values can be changed without writing the forced variable
+        if (varp->isForceable()) supported = false;
+        if (!(varp->isPrimaryIO() && varp->isNonOutput()) && !varp->isSigUserRWPublic()) return;
+        if (!isSnapshotVar(vscp)) supported = false;
+        inputs.push_back(vscp);
+    });
+    if (!supported || !evalp->stmtsp()) {
+        V3Stats::addStat("Scheduling, eval skip inputs", 0);
+        return;
+    }
+
+    // Count of skipped evaluations, and whether there is a snapshot
+    AstVarScope* const validVscp = scopeTopp->createTemp("__VevalSnapshotValid", 1);
+    AstVarScope* const skippedVscp = scopeTopp->createTemp("__VevalsSkipped", 64);
+    initFuncp->addStmtsp(setVar(validVscp, 0));
+    initFuncp->addStmtsp(setVar(skippedVscp, 0));
+    netlistp->evalsSkippedp(skippedVscp->varp());
+
+    // Build the change check, and the updates of the snapshot
+    AstNodeExpr* condp = new AstLogNot{flp, new AstVarRef{flp, validVscp, VAccess::READ}};
+    AstNode* updatesp = setVar(validVscp, 1);
+    size_t n = 0;
+    for (AstVarScope* const vscp : inputs) {
+        AstVarScope* const prevp
+            = scopeTopp->createTempLike("__VevalSnapshot" + cvtToStr(n++), vscp);
+        AstNodeExpr* const currp = new AstVarRef{flp, vscp, VAccess::READ};
+        AstNodeExpr* const snapp = new AstVarRef{flp, prevp, VAccess::READ};
+        AstNodeExpr* changedp;
+        if (currp->isDouble()) {
+            changedp = new AstNeqD{flp, currp, snapp};
+        } else if (currp->isString()) {
+            changedp = new AstNeqN{flp, currp, snapp};
+        } else {
+            changedp = new AstNeq{flp, currp, snapp};
+        }
+        condp = new AstLogOr{flp, condp, changedp};
+        updatesp->addNext(new AstAssign{flp, new AstVarRef{flp, prevp, VAccess::WRITE},
+                                        new AstVarRef{flp, vscp, VAccess::READ}});
+    }
+    // Delays due at the current time
+    if (dlySchedVscp) {
+        AstCMethodHard* const awaitingp = new AstCMethodHard{
+            flp, new AstVarRef{flp, dlySchedVscp, VAccess::READ}, "awaitingCurrentTime"};
+        awaitingp->dtypeSetBit();
+        condp = new AstLogOr{flp, condp, awaitingp};
+    }
+    // DPI exports called since the last evaluation
+    if (AstVarScope* const dpiExportTriggerVscp = netlistp->dpiExportTriggerp()) {
+        condp = new AstLogOr{flp, condp,
+                             new AstVarRef{flp, dpiExportTriggerVscp, VAccess::READ}};
+    }
+
+    // Wrap the body
+    AstNode* const bodyp = evalp->stmtsp()->unlinkFrBackWithNext();
+    AstIf* const ifp = new AstIf{flp, condp};
+    ifp->addThensp(bodyp);
+    ifp->addThensp(updatesp);
+    AstAdd* const incp = new AstAdd{flp, new AstVarRef{flp, skippedVscp, VAccess::READ},
+                                    new AstConst{flp, AstConst::WidthedValue{}, 64, 1}};
+    incp->dtypeFrom(skippedVscp);
+    ifp->addElsesp(new AstAssign{flp, new AstVarRef{flp, skippedVscp, VAccess::WRITE}, incp});
+    evalp->addStmtsp(ifp);
+
+    V3Stats::addStat("Scheduling, eval skip inputs", inputs.size());
+}
+
 }  // namespace
 
 //============================================================================
@@ -1082,11 +1313,69 @@ void schedule(AstNetlist* netlistp) {
         V3Stats::statsStage("sched-replicate");
     }
 
+    // Remember the combinational statements in the 'nba' region, for activity gating
+    std::unordered_set<const AstNode*> nbaCombStmts;
+    if (v3Global.opt.activityGating()) {
+        for (const LogicByScope* lbsp : {&logicRegions.m_nba, &logicReplicas.m_nba}) {
+            for (const auto& pair : *lbsp) {
+                if (!pair.second->sensesp()->hasCombo()) continue;
+                for (AstNode* nodep = pair.second->stmtsp(); nodep; nodep = nodep->nextp()) {
+                    // V3Order moves the body of procedures into functions one by one
+                    AstNodeProcedure* const procp = VN_CAST(nodep, NodeProcedure);
+                    if (!procp) {
+                        nbaCombStmts.insert(nodep);
+                        continue;
+                    }
+                    for (AstNode* stmtp = procp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+                        nbaCombStmts.insert(stmtp);
+                    }
+                }
+            }
+        }
+    }
+
+    // Final steps, common to all schedules
+    const auto finalize = [&](AstCFunc* nbaFuncp) {
+        transformForks(netlistp);
+
+        // Skip combinational logic with unchanged inputs, if requested
+        if (v3Global.opt.activityGating()) {
+            gateCombinational(netlistp, nbaFuncp, initp, nbaCombStmts);
+        }
+
+        // Skip evaluation with unchanged inputs, if requested
+        if (v3Global.opt.evalSkipUnchanged()) createEvalSkip(netlistp, initp);
+
+        splitCheck(initp);
+
+        netlistp->dpiExportTriggerp(nullptr);
+
+        V3Global::dumpCheckGlobalTree("sched", 0, dumpTreeLevel() >= 3);
+    };
+
+    // Designs with a single clock can use a simplified schedule, if enabled
+    const AstSenTree* const singleClockSenTreep
+        = singleClockSenTree(netlistp, logicClasses, logicRegions, logicReplicas, timingKit);
+
     // Step 7: Create input combinational logic loop
-    AstNode* const icoLoopp
-        = createInputCombLoop(netlistp, initp, senExprBuilder, logicReplicas.m_ico);
+    const bool singleClock = singleClockSenTreep != nullptr;
+    AstNode* const icoLoopp = createInputCombLoop(netlistp, initp, senExprBuilder,
+                                                  logicReplicas.m_ico, singleClock);
     if (v3Global.opt.stats()) V3Stats::statsStage("sched-create-ico");
 
+    if (singleClockSenTreep) {
+        // Steps 8 to 14: Create the 'nba' region and the straight line '_eval' function
+        AstCFunc* const postponedFuncp = createPostponed(netlistp, logicClasses);
+        AstCFunc* const nbaFuncp
+            = createSingleClockEval(netlistp, initp, senExprBuilder, icoLoopp,
+                                    singleClockSenTreep, logicRegions, logicReplicas,
+                                    postponedFuncp);
+        V3Stats::addStat("Scheduling, single clock eval", 1);
+        if (v3Global.opt.stats()) V3Stats::statsStage("sched-create-single-clock");
+        finalize(nbaFuncp);
+        return;
+    }
+
     // Step 8: Create the pre/act/nba triggers
     AstVarScope* const dpiExportTriggerVscp = netlistp->dpiExportTriggerp();
 
@@ -1248,13 +1537,7 @@ void schedule(AstNetlist* netlistp) {
     createEval(netlistp, icoLoopp, actKit, preTrigVscp, nbaKit, obsKit, reactKit, postponedFuncp,
                timingKit);
 
-    transformForks(netlistp);
-
-    splitCheck(initp);
-
-    netlistp->dpiExportTriggerp(nullptr);
-
-    V3Global::dumpCheckGlobalTree("sched", 0, dumpTreeLevel() >= 3);
+    finalize(nbaKit.m_funcp);
 }
 
 }  // namespace V3Sched
@@ -24,6 +24,7 @@
 
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -162,6 +163,8 @@ LogicByScope breakCycles(AstNetlist* netlistp, LogicByScope& combinationalLogic)
 LogicRegions partition(LogicByScope& clockedLogic, LogicByScope& combinationalLogic,
                        LogicByScope& hybridLogic);
 LogicReplicas replicateLogic(LogicRegions&);
+void gateCombinational(AstNetlist* netlistp, AstCFunc* nbaFuncp, AstCFunc* initFuncp,
+                       const std::unordered_set<const AstNode*>& combStmts);
 
 }  // namespace V3Sched
 
@@ -31,6 +31,12 @@
 // variables is converted into hybrid logic, with the back-edge driven
 // variables listed as explicit 'changed' sensitivities.
 //
+// With -fsched-scc-settle, the logic of a strongly connected component is
+// instead combined into a single 'settle loop' procedure where possible. This
+// evaluates the logic of the component in dependency order, repeatedly, until
+// all variables it both writes and reads are stable. This avoids re-evaluating
+// the whole enclosing region just to settle a small feedback loop.
+//
 //*************************************************************************
 
 #include "config_build.h"
@@ -38,6 +44,7 @@
 
 #include "V3Ast.h"
 #include "V3Error.h"
+#include "V3File.h"
 #include "V3Global.h"
 #include "V3Graph.h"
 #include "V3Sched.h"
@@ -47,6 +54,7 @@
 
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -390,6 +398,299 @@ LogicByScope fixCuts(AstNetlist* netlistp, const std::vector<VarVertex*>& cutVer
     return result;
 }
 
+// A strongly connected component that might be settled by a local fixed-point loop
+struct SettleScc final {
+    std::vector<VarVertex*> m_cutVertices;  // The cut variables of this component
+    std::vector<AstNode*> m_logicps;  // The logic of this component, in evaluation order
+    bool m_settle = true;  // Settle this component locally
+};
+
+// Gather the strongly connected components, with their logic ordered by rank. Must be called
+// after the graph was made acyclic and ranked, while the cut edges still have zero weight.
+std::vector<SettleScc> gatherSettleSccs(Graph* graphp,
+                                        const std::vector<VarVertex*>& cutVertices) {
+    std::vector<SettleScc> sccs;
+    std::unordered_map<uint32_t, size_t> color2Scc;
+    for (VarVertex* const vvtxp : cutVertices) {
+        const auto pair = color2Scc.emplace(vvtxp->color(), sccs.size());
+        if (pair.second) sccs.emplace_back();
+        sccs[pair.first->second].m_cutVertices.push_back(vvtxp);
+    }
+    std::vector<LogicVertex*> lvtxps;
+    for (V3GraphVertex* vtxp = graphp->verticesBeginp(); vtxp; vtxp = vtxp->verticesNextp()) {
+        LogicVertex* const lvtxp = dynamic_cast<LogicVertex*>(vtxp);
+        if (lvtxp && color2Scc.count(lvtxp->color())) lvtxps.push_back(lvtxp);
+    }
+    std::stable_sort(lvtxps.begin(), lvtxps.end(),
+                     [](const LogicVertex* ap, const LogicVertex* bp) {  //
+                         return ap->rank() < bp->rank();
+                     });
+    for (LogicVertex* const lvtxp : lvtxps) {
+        sccs[color2Scc.at(lvtxp->color())].m_logicps.push_back(lvtxp->logicp());
+    }
+    return sccs;
+}
+
+// Can this variable be compared to detect convergence of a settle loop
+bool isSettleVar(const AstVarScope* vscp) {
+    const AstNodeDType* const dtypep = vscp->dtypep()->skipRefp();
+    if (const AstBasicDType* const basicp = VN_CAST(dtypep, BasicDType)) {
+        return !basicp->isOpaque();
+    }
+    return VN_IS(dtypep, PackArrayDType)
+           || (VN_IS(dtypep, NodeUOrStructDType) && VN_AS(dtypep, NodeUOrStructDType)->packed());
+}
+
+// Can this logic be moved into a settle loop
+bool isSettleLogic(const AstNode* logicp) {
+    if (const AstAlways* const alwaysp = VN_CAST(logicp, Always)) {
+        return !alwaysp->isSuspendable() && !alwaysp->needProcess();
+    }
+    if (const AstAssignW* const assignp = VN_CAST(logicp, AssignW)) {
+        return !assignp->timingControlp();
+    }
+    return false;
+}
+
+class SettleLoopBuilder final {
+    // STATE
+    AstNetlist* const m_netlistp;
+    // Scope and AstActive of each combinational logic node
+    std::unordered_map<const AstNode*, std::pair<AstScope*, AstActive*>> m_logicInfo;
+    // All combinational logic writing each variable
+    std::unordered_map<const AstVarScope*, std::vector<AstNode*>> m_writers;
+    // The component each logic node belongs to
+    std::unordered_map<const AstNode*, size_t> m_logic2Scc;
+    size_t m_nSettled = 0;  // Number of settle loops created
+
+    // METHODS
+
+    // Add all other writers of variables that are both written and read by the component to
+    // its logic, so none of them can be ordered after the settle loop. These are not part of
+    // any cycle, so their inputs do not depend on the component.
+    void addWriters(SettleScc& scc, size_t index) {
+        std::unordered_set<const AstNode*> members{scc.m_logicps.begin(), scc.m_logicps.end()};
+        std::vector<AstNode*> writersp;
+        bool changed = true;
+        while (changed && scc.m_settle) {
+            changed = false;
+            for (const AstVarScope* const vscp : feedbackVars(scc.m_logicps, writersp)) {
+                for (AstNode* const logicp : m_writers.at(vscp)) {
+                    if (members.count(logicp)) continue;
+                    if (m_logic2Scc.count(logicp)) {
+                        scc.m_settle = false;
+                        return;
+                    }
+                    members.insert(logicp);
+                    writersp.push_back(logicp);
+                    m_logic2Scc.emplace(logicp, index);
+                    changed = true;
+                }
+            }
+        }
+        scc.m_logicps.insert(scc.m_logicps.begin(), writersp.begin(), writersp.end());
+    }
+
+    // Variables both written and read by the given logic, in a deterministic order
+    static std::vector<AstVarScope*> feedbackVars(const std::vector<AstNode*>& logicps,
+                                                  const std::vector<AstNode*>& extrasp = {}) {
+        std::unordered_set<const AstVarScope*> written;
+        std::unordered_set<const AstVarScope*> read;
+        std::vector<AstVarScope*> vscps;
+        const auto gather = [&](const std::vector<AstNode*>& nodeps) {
+            for (AstNode* const logicp : nodeps) {
+                logicp->foreach([&](AstVarRef* refp) {
+                    AstVarScope* const vscp = refp->varScopep();
+                    if (refp->access().isWriteOrRW()) written.insert(vscp);
+                    if (refp->access().isReadOrRW()) read.insert(vscp);
+                    vscps.push_back(vscp);
+                });
+            }
+        };
+        gather(extrasp);
+        gather(logicps);
+        std::vector<AstVarScope*> result;
+        std::unordered_set<const AstVarScope*> done;
+        for (AstVarScope* const vscp : vscps) {
+            if (!written.count(vscp) || !read.count(vscp)) continue;
+            if (done.insert(vscp).second) result.push_back(vscp);
+        }
+        return result;
+    }
+
+    // Can the component be settled locally, given the cut variables that remain cut
+    bool canSettle(const SettleScc& scc,
+                   const std::unordered_set<const AstVarScope*>& remainingCuts) const {
+        AstScope* const scopep = m_logicInfo.at(scc.m_logicps.front()).first;
+        for (const AstNode* const logicp : scc.m_logicps) {
+            if (!isSettleLogic(logicp)) return false;
+            if (m_logicInfo.at(logicp).first != scopep) return false;
+            // Readers of cut variables that remain cut will be converted to hybrid logic
+            const bool readsCut = logicp->exists([&](const AstVarRef* refp) {
+                return refp->access().isReadOrRW() && remainingCuts.count(refp->varScopep());
+            });
+            if (readsCut) return false;
+        }
+        for (const AstVarScope* const vscp : feedbackVars(scc.m_logicps)) {
+            if (!isSettleVar(vscp)) return false;
+        }
+        return true;
+    }
+
+    // Replace the logic of the component with a settle loop
+    void settle(const SettleScc& scc) {
+        const size_t id = m_nSettled++;
+        const string prefix = "__Vsettle" + cvtToStr(id);
+        AstNode* const firstp = scc.m_logicps.front();
+        FileLine* const flp = firstp->fileline();
+        AstScope* const scopeTopp = m_netlistp->topScopep()->scopep();
+        const std::vector<AstVarScope*> vscps = feedbackVars(scc.m_logicps);
+        UASSERT_OBJ(!vscps.empty(), firstp, "Settle loop without feedback variables");
+        // The logic is deleted below, so find where to add the loop now
+        AstActive* const activep = m_logicInfo.at(firstp).second;
+
+        const auto read = [&](AstVarScope* vscp) {  //
+            return new AstVarRef{flp, vscp, VAccess::READ};
+        };
+        const auto assign = [&](AstVarScope* vscp, AstNodeExpr* valuep) {
+            return new AstAssign{flp, new AstVarRef{flp, vscp, VAccess::WRITE}, valuep};
+        };
+        const auto constant = [&](uint32_t value) {
+            return new AstConst{flp, AstConst::WidthedValue{}, 32, value};
+        };
+
+        AstVarScope* const continuep = scopeTopp->createTemp(prefix + "Continue", 1);
+        continuep->varp()->noReset(true);
+        AstVarScope* const iterp = scopeTopp->createTemp(prefix + "IterCount", 32);
+        iterp->varp()->noReset(true);
+
+        AstAlways* const alwaysp = new AstAlways{flp, VAlwaysKwd::ALWAYS, nullptr, nullptr};
+        alwaysp->setSettleLoop();
+        alwaysp->addStmtsp(assign(iterp, constant(0)));
+        alwaysp->addStmtsp(assign(continuep, new AstConst{flp, AstConst::BitTrue{}}));
+        AstWhile* const loopp = new AstWhile{flp, read(continuep)};
+        alwaysp->addStmtsp(loopp);
+        loopp->addStmtsp(assign(iterp, new AstAdd{flp, read(iterp), constant(1)}));
+
+        // Save the feedback variables
+        std::vector<AstVarScope*> prevps;
+        for (AstVarScope* const vscp : vscps) {
+            AstVarScope* const prevp
+                = scopeTopp->createTempLike(prefix + "Prev" + cvtToStr(prevps.size()), vscp);
+            prevp->varp()->noReset(true);
+            loopp->addStmtsp(assign(prevp, read(vscp)));
+            prevps.push_back(prevp);
+        }
+
+        // Move the logic into the loop
+        for (AstNode* const logicp : scc.m_logicps) {
+            logicp->unlinkFrBack();
+            if (AstAlways* const logicAlwaysp = VN_CAST(logicp, Always)) {
+                if (logicAlwaysp->stmtsp()) {
+                    loopp->addStmtsp(logicAlwaysp->stmtsp()->unlinkFrBackWithNext());
+                }
+            } else {
+                AstAssignW* const assignp = VN_AS(logicp, AssignW);
+                loopp->addStmtsp(new AstAssign{assignp->fileline(),
+                                               assignp->lhsp()->unlinkFrBack(),
+                                               assignp->rhsp()->unlinkFrBack()});
+            }
+            m_logicInfo.erase(logicp);
+            VL_DO_DANGLING(logicp->deleteTree(), logicp);
+        }
+
+        // Iterate while any feedback variable changed
+        AstNodeExpr* changedp = nullptr;
+        for (size_t i = 0; i < vscps.size(); ++i) {
+            AstNodeExpr* const neqp = new AstNeq{flp, read(vscps[i]), read(prevps[i])};
+            changedp = changedp ? new AstOr{flp, changedp, neqp} : neqp;
+        }
+        loopp->addStmtsp(assign(continuep, changedp));
+
+        // If we exceeded the iteration limit, die
+        {
+            AstConst* const limitp = constant(v3Global.opt.convergeLimit());
+            AstIf* const failp = new AstIf{
+                flp, new AstAnd{flp, read(continuep), new AstGt{flp, read(iterp), limitp}}};
+            failp->branchPred(VBranchPred::BP_UNLIKELY);
+            const string& file = VIdProtect::protect(flp->filename());
+            const string& line = cvtToStr(flp->lineno());
+            failp->addThensp(new AstCStmt{flp, "VL_FATAL_MT(\"" + file + "\", " + line
+                                                   + ", \"\", \"Combinational loop did not "
+                                                     "converge.\");\n"});
+            loopp->addStmtsp(failp);
+        }
+
+        // Count iterations when profiling
+        if (v3Global.opt.profExec()) {
+            const string& name
+                = VIdProtect::protect(flp->filename()) + ":" + cvtToStr(flp->lineno());
+            AstCStmt* const countp = new AstCStmt{
+                flp, "VL_EXEC_SETTLE_COUNT(vlSymsp, " + cvtToStr(id) + ", \"" + name + "\", "};
+            countp->addExprsp(read(iterp));
+            countp->addExprsp(new AstText{flp, ");\n"});
+            alwaysp->addStmtsp(countp);
+        }
+
+        // Add to the combinational logic of the scope
+        activep->addStmtsp(alwaysp);
+    }
+
+public:
+    SettleLoopBuilder(AstNetlist* netlistp, const LogicByScope& lbs)
+        : m_netlistp{netlistp} {
+        for (const auto& pair : lbs) {
+            for (AstNode* nodep = pair.second->stmtsp(); nodep; nodep = nodep->nextp()) {
+                if (VN_IS(nodep, AlwaysPostponed)) continue;
+                m_logicInfo.emplace(nodep, pair);
+                nodep->foreach([&](const AstVarRef* refp) {
+                    if (!refp->access().isWriteOrRW()) return;
+                    std::vector<AstNode*>& writers = m_writers[refp->varScopep()];
+                    if (writers.empty() || writers.back() != nodep) writers.push_back(nodep);
+                });
+            }
+        }
+    }
+
+    // Settle components locally where possible, return the cut vertices of the rest
+    std::vector<VarVertex*> build(std::vector<SettleScc>& sccs) {
+        for (size_t i = 0; i < sccs.size(); ++i) {
+            for (const AstNode* const logicp : sccs[i].m_logicps) m_logic2Scc.emplace(logicp, i);
+        }
+        for (size_t i = 0; i < sccs.size(); ++i) addWriters(sccs[i], i);
+
+        // Settling a component requires all of its logic to be settled too, so iterate
+        std::unordered_set<const AstVarScope*> remainingCuts;
+        const auto giveUp = [&](SettleScc& scc) {
+            scc.m_settle = false;
+            for (VarVertex* const vvtxp : scc.m_cutVertices) remainingCuts.insert(vvtxp->vscp());
+        };
+        for (SettleScc& scc : sccs) {
+            if (!scc.m_settle) giveUp(scc);
+        }
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (SettleScc& scc : sccs) {
+                if (scc.m_settle && !canSettle(scc, remainingCuts)) {
+                    giveUp(scc);
+                    changed = true;
+                }
+            }
+        }
+
+        std::vector<VarVertex*> result;
+        for (SettleScc& scc : sccs) {
+            if (scc.m_settle) {
+                settle(scc);
+            } else {
+                result.insert(result.end(), scc.m_cutVertices.begin(), scc.m_cutVertices.end());
+            }
+        }
+        V3Stats::addStat("Scheduling, SCC settle loops", m_nSettled);
+        return result;
+    }
+};
+
 }  // namespace
 
 LogicByScope breakCycles(AstNetlist* netlistp, LogicByScope& combinationalLogic) {
@@ -414,12 +715,26 @@ LogicByScope breakCycles(AstNetlist* netlistp, LogicByScope& combinationalLogic)
     // Find all cut vertices
     const std::vector<VarVertex*> cutVertices = findCutVertices(graphp.get());
 
+    // Gather the components to settle locally, ordering their logic by rank
+    std::vector<SettleScc> settleSccs;
+    if (v3Global.opt.fSchedSccSettle()) {
+        graphp->rank();
+        settleSccs = gatherSettleSccs(graphp.get(), cutVertices);
+    }
+
     // Reset edge weights for reporting
     resetEdgeWeights(cutVertices);
 
     // Report warnings/diagnostics
     reportCycles(graphp.get(), cutVertices);
 
+    // Replace components with settle loops where possible, leaving the rest cut
+    if (v3Global.opt.fSchedSccSettle()) {
+        const std::vector<VarVertex*> remainingCuts
+            = SettleLoopBuilder{netlistp, combinationalLogic}.build(settleSccs);
+        return fixCuts(netlistp, remainingCuts);
+    }
+
     // Fix cuts by converting dependent logic to use hybrid sensitivities
     return fixCuts(netlistp, cutVertices);
 }
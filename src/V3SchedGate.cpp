@@ -0,0 +1,284 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Scheduling - activity gating of combinational logic
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2023 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+//
+// With --activity-gating, the combinational functions created by V3Order
+// for the 'nba' region are wrapped in a check of whether any of the
+// variables they read changed since the function last executed:
+//
+//      if (!__VgateN__valid | (a != __VgateN__prev0) | (b != __VgateN__prev1)) {
+//          <original body>
+//          __VgateN__valid = 1;
+//          __VgateN__prev0 = a;
+//          __VgateN__prev1 = b;
+//      }
+//
+// The function is then skipped in evaluations where its inputs are
+// unchanged, e.g. in idle, clock gated parts of the design. The previous
+// values are captured after the body, so variables written by the body and
+// then read back (temporaries within an always_comb) do not force
+// re-evaluation.
+//
+// Skipping is only sound if the outputs of the function still hold the
+// values it last computed, so a function is only gated if no other logic
+// in the 'nba' region writes its outputs, and functions outside the 'nba'
+// region that write them (e.g. the replicated copies in 'ico' and 'act',
+// and initial blocks) clear the valid flag. Functions that are impure,
+// call other functions, or reference variables without a cheap equality
+// comparison are never gated. Finally, a function is only gated if its
+// body is expensive enough compared to the input check.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3Ast.h"
+#include "V3Error.h"
+#include "V3InstrCount.h"
+#include "V3Sched.h"
+#include "V3Stats.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+namespace V3Sched {
+
+namespace {
+
+// Only gate a function if its body costs this many times the instructions of the input check
+constexpr uint32_t GATE_COST_RATIO = 2;
+
+//##############################################################################
+// Collect variable writers of all functions
+
+class GateWritersVisitor final : public VNVisitorConst {
+    // STATE
+    AstCFunc* m_cfuncp = nullptr;  // Current function
+    // Map from variable to the functions writing it. Writes outside functions map to nullptr.
+    std::unordered_map<const AstVarScope*, std::vector<AstCFunc*>>& m_writers;
+
+    // VISITORS
+    void visit(AstCFunc* nodep) override {
+        VL_RESTORER(m_cfuncp);
+        m_cfuncp = nodep;
+        iterateChildrenConst(nodep);
+    }
+    void visit(AstVarRef* nodep) override {
+        if (!nodep->access().isWriteOrRW()) return;
+        std::vector<AstCFunc*>& writerps = m_writers[nodep->varScopep()];
+        if (std::find(writerps.begin(), writerps.end(), m_cfuncp) == writerps.end()) {
+            writerps.push_back(m_cfuncp);
+        }
+    }
+    void visit(AstNode* nodep) override { iterateChildrenConst(nodep); }
+
+public:
+    // CONSTRUCTORS
+    GateWritersVisitor(AstNetlist* netlistp,
+                       std::unordered_map<const AstVarScope*, std::vector<AstCFunc*>>& writers)
+        : m_writers{writers} {
+        iterateConst(netlistp);
+    }
+    ~GateWritersVisitor() override = default;
+};
+
+//##############################################################################
+// Activity gating
+
+class GateComb final {
+    // STATE
+    AstScope* const m_scopeTopp;  // The top level scope, where state variables are created
+    AstCFunc* const m_initFuncp;  // Initialization function, clears all valid flags
+    // Functions reachable from the 'nba' region evaluation function, in traversal order
+    std::vector<AstCFunc*> m_nbaFuncps;
+    std::unordered_set<const AstCFunc*> m_nbaFuncSet;  // Same as m_nbaFuncps, for lookup
+    // Writers of each variable
+    std::unordered_map<const AstVarScope*, std::vector<AstCFunc*>> m_writers;
+    size_t m_nGated = 0;  // Number of gated functions
+
+    // METHODS
+    void gatherReachable(AstCFunc* funcp) {
+        if (!m_nbaFuncSet.insert(funcp).second) return;
+        m_nbaFuncps.push_back(funcp);
+        funcp->foreach([this](AstNodeCCall* callp) { gatherReachable(callp->funcp()); });
+    }
+
+    // Can the value of this variable be compared and copied cheaply
+    static bool isGateableVar(const AstVarScope* vscp) {
+        const AstVar* const varp = vscp->varp();
+        if (varp->isFuncLocal() || varp->isSc()) return false;
+        const AstNodeDType* const dtypep = vscp->dtypep()->skipRefp();
+        if (const AstBasicDType* const basicp = VN_CAST(dtypep, BasicDType)) {
+            return !basicp->isOpaque();
+        }
+        return VN_IS(dtypep, PackArrayDType)
+               || (VN_IS(dtypep, NodeUOrStructDType)
+                   && VN_AS(dtypep, NodeUOrStructDType)->packed());
+    }
+
+    // Returns true if the function can be gated, and gathers its inputs and outputs
+    bool isGateable(AstCFunc* funcp, const std::unordered_set<const AstNode*>& combStmts,
+                    std::vector<AstVarScope*>& inputs, std::vector<AstVarScope*>& outputs) const {
+        if (funcp->isCoroutine() || funcp->needProcess() || !funcp->stmtsp()) return false;
+        if (funcp->rtnTypeVoid() != "void" || funcp->argsp() || funcp->initsp()) return false;
+        for (AstNode* nodep = funcp->stmtsp(); nodep; nodep = nodep->nextp()) {
+            // All statements must come from combinational logic
+            if (!combStmts.count(nodep)) return false;
+            // All operations must be side effect free and only reference state via variables
+            const bool bad = nodep->exists([](const AstNode* np) {
+                return !np->isPure() || !np->isGateOptimizable()  //
+                       || VN_IS(np, NodeCCall) || VN_IS(np, NodeFTaskRef)
+                       || VN_IS(np, CMethodHard) || VN_IS(np, CExpr) || VN_IS(np, CStmt)
+                       || VN_IS(np, NodeSimpleText) || VN_IS(np, VarXRef);
+            });
+            if (bad) return false;
+        }
+        bool ok = true;
+        std::unordered_set<const AstVarScope*> inputSet;
+        std::unordered_set<const AstVarScope*> outputSet;
+        funcp->foreach([&](AstVarRef* refp) {
+            AstVarScope* const vscp = refp->varScopep();
+            if (!vscp || !isGateableVar(vscp)) {
+                ok = false;
+                return;
+            }
+            if (refp->access().isReadOrRW() && inputSet.insert(vscp).second) {
+                inputs.push_back(vscp);
+            }
+            if (refp->access().isWriteOrRW() && outputSet.insert(vscp).second) {
+                outputs.push_back(vscp);
+            }
+        });
+        if (!ok) return false;
+        // Outputs must only be changed by this function while in the 'nba' region, and
+        // only at well defined points elsewhere
+        for (const AstVarScope* const vscp : outputs) {
+            const AstVar* const varp = vscp->varp();
+            if (varp->isWrittenByDpi() || varp->isSigUserRWPublic() || varp->isForceable()) {
+                return false;
+            }
+            for (const AstCFunc* const writerp : m_writers.at(vscp)) {
+                if (writerp == funcp) continue;
+                if (!writerp || writerp->isCoroutine() || m_nbaFuncSet.count(writerp)) {
+                    return false;
+                }
+            }
+        }
+        // The check must be cheap compared to the body
+        uint32_t checkCost = 1;
+        for (const AstVarScope* const vscp : inputs) checkCost += vscp->dtypep()->widthWords();
+        return V3InstrCount::count(funcp, false) >= GATE_COST_RATIO * checkCost;
+    }
+
+    AstNodeStmt* clearValid(AstVarScope* validp) const {
+        FileLine* const flp = validp->fileline();
+        return new AstAssign{flp, new AstVarRef{flp, validp, VAccess::WRITE},
+                             new AstConst{flp, AstConst::BitFalse{}}};
+    }
+
+    void gate(AstCFunc* funcp, const std::vector<AstVarScope*>& inputs,
+              const std::vector<AstVarScope*>& outputs) {
+        FileLine* const flp = funcp->fileline();
+        const string prefix = "__Vgate" + cvtToStr(m_nGated++) + "__";
+        UINFO(5, "Activity gating " << funcp << endl);
+
+        // Valid flag, cleared on initialization and by all other writers of the outputs
+        AstVarScope* const validp = m_scopeTopp->createTemp(prefix + "valid", 1);
+        m_initFuncp->addStmtsp(clearValid(validp));
+        std::unordered_set<const AstCFunc*> writerSet;
+        for (const AstVarScope* const vscp : outputs) {
+            for (AstCFunc* const writerp : m_writers.at(vscp)) {
+                if (writerp == funcp || !writerSet.insert(writerp).second) continue;
+                // Prepend, so it is done even if the function returns early
+                if (writerp->stmtsp()) {
+                    writerp->stmtsp()->addHereThisAsNext(clearValid(validp));
+                } else {
+                    writerp->addStmtsp(clearValid(validp));
+                }
+            }
+        }
+
+        // Build the input change check, and the updates of the previous values
+        AstNodeExpr* condp = new AstNot{flp, new AstVarRef{flp, validp, VAccess::READ}};
+        AstNode* updatesp = new AstAssign{flp, new AstVarRef{flp, validp, VAccess::WRITE},
+                                          new AstConst{flp, AstConst::BitTrue{}}};
+        size_t n = 0;
+        for (AstVarScope* const vscp : inputs) {
+            AstVarScope* const prevp
+                = m_scopeTopp->createTempLike(prefix + "prev" + cvtToStr(n++), vscp);
+            AstNodeExpr* const changedp = new AstNeq{flp, new AstVarRef{flp, vscp, VAccess::READ},
+                                                     new AstVarRef{flp, prevp, VAccess::READ}};
+            condp = new AstOr{flp, condp, changedp};
+            updatesp->addNext(new AstAssign{flp, new AstVarRef{flp, prevp, VAccess::WRITE},
+                                            new AstVarRef{flp, vscp, VAccess::READ}});
+        }
+
+        // Wrap the body
+        AstNode* const bodyp = funcp->stmtsp()->unlinkFrBackWithNext();
+        AstIf* const ifp = new AstIf{flp, condp};
+        if (v3Global.opt.profExec()) {
+            ifp->addThensp(new AstCStmt{flp, "VL_EXEC_GATE_COUNT(vlSymsp, false);\n"});
+            ifp->addElsesp(new AstCStmt{flp, "VL_EXEC_GATE_COUNT(vlSymsp, true);\n"});
+        }
+        ifp->addThensp(bodyp);
+        ifp->addThensp(updatesp);
+        funcp->addStmtsp(ifp);
+    }
+
+public:
+    // CONSTRUCTORS
+    GateComb(AstNetlist* netlistp, AstCFunc* nbaFuncp, AstCFunc* initFuncp,
+             const std::unordered_set<const AstNode*>& combStmts)
+        : m_scopeTopp{netlistp->topScopep()->scopep()}
+        , m_initFuncp{initFuncp} {
+        gatherReachable(nbaFuncp);
+        { GateWritersVisitor{netlistp, m_writers}; }
+
+        // Gather candidates first, as gating adds writes to other functions
+        struct Candidate final {
+            AstCFunc* m_funcp;
+            std::vector<AstVarScope*> m_inputs;
+            std::vector<AstVarScope*> m_outputs;
+        };
+        std::vector<Candidate> candidates;
+        for (AstCFunc* const funcp : m_nbaFuncps) {
+            Candidate candidate{funcp, {}, {}};
+            if (!isGateable(funcp, combStmts, candidate.m_inputs, candidate.m_outputs)) continue;
+            candidates.push_back(std::move(candidate));
+        }
+        for (const Candidate& candidate : candidates) {
+            gate(candidate.m_funcp, candidate.m_inputs, candidate.m_outputs);
+        }
+        V3Stats::addStat("Scheduling, activity gated functions", m_nGated);
+    }
+};
+
+}  // namespace
+
+//============================================================================
+// Top level entry point
+
+void gateCombinational(AstNetlist* netlistp, AstCFunc* nbaFuncp, AstCFunc* initFuncp,
+                       const std::unordered_set<const AstNode*>& combStmts) {
+    GateComb{netlistp, nbaFuncp, initFuncp, combStmts};
+    V3Global::dumpCheckGlobalTree("sched_gate", 0, dumpTreeLevel() >= 6);
+}
+
+}  // namespace V3Sched
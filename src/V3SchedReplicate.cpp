@@ -42,6 +42,8 @@
 #include "V3Graph.h"
 #include "V3Sched.h"
 
+#include <unordered_set>
+
 VL_DEFINE_DEBUG_FUNCTIONS;
 
 namespace V3Sched {
@@ -187,6 +189,16 @@ std::unique_ptr<Graph> buildGraph(const LogicRegions& logicRegions) {
             const VNUser2InUse user2InUse;
             const VNUser3InUse user3InUse;
 
+            // Logic settling a combinational loop does not consume its own outputs (see
+            // V3Order), so mark them as written up front
+            const AstAlways* const alwaysp = VN_CAST(nodep, Always);
+            std::unordered_set<const AstVarScope*> settleOutputs;
+            if (alwaysp && alwaysp->isSettleLoop()) {
+                nodep->foreach([&](const AstVarRef* refp) {
+                    if (refp->access().isWriteOrRW()) settleOutputs.insert(refp->varScopep());
+                });
+            }
+
             nodep->foreach([&](AstVarRef* refp) {
                 AstVarScope* const vscp = refp->varScopep();
                 VarVertex* const vvtxp = getVarVertex(vscp);
@@ -195,7 +207,8 @@ std::unique_ptr<Graph> buildGraph(const LogicRegions& logicRegions) {
                 // Note: Use same heuristic as ordering does to ignore written variables
                 // TODO: Use live variable analysis.
                 if (refp->access().isReadOrRW() && !vscp->user3SetOnce()
-                    && readTriggersThisLogic(vscp) && !vscp->user2()) {  //
+                    && readTriggersThisLogic(vscp) && !vscp->user2()
+                    && !settleOutputs.count(vscp)) {  //
                     addEdge(vvtxp, lvtxp);
                 }
                 // If written, add logic -> var edge
@@ -40,6 +40,16 @@
 //         - create a join sync variable
 //         - create statements that sync the main process with its children
 //
+// With -ftiming-trigger-deps, dynamic triggers whose dependencies are all known variables are
+// grouped by their dependencies. Such triggers await dependentEvaluation() with their group, and
+// DynamicTriggerMarkVisitor marks the group dirty after each statement writing one of these
+// variables, so that the trigger is re-evaluated only then.
+//
+// With -ftiming-parallel and --threads, processes only waiting on delays, and only running
+// statements that access nothing but the variables they reference, are candidates for parallel
+// resumption. TimingParallelVisitor picks candidates that access no variable another picked one
+// writes, and their delays use delayParallel(), so that the runtime resumes them concurrently.
+//
 // See the internals documentation docs/internals.rst for more details.
 //
 //*************************************************************************
@@ -56,6 +66,7 @@
 #include "V3MemberMap.h"
 #include "V3SenExprBuilder.h"
 #include "V3SenTree.h"
+#include "V3Stats.h"
 #include "V3UniqueNames.h"
 
 #include <queue>
@@ -358,6 +369,213 @@ public:
     ~TimingSuspendableVisitor() override = default;
 };
 
+// ######################################################################
+//  Mark dynamic trigger dependency groups dirty where their variables are written
+
+class DynamicTriggerMarkVisitor final : public VNVisitor {
+private:
+    // STATE
+    // Dependency groups of each variable
+    const std::unordered_map<const AstVar*, std::set<uint32_t>>& m_varGroups;
+    const string m_schedName;  // Name of the dynamic trigger scheduler in the top scope
+    std::set<uint32_t>* m_groupsp = nullptr;  // Groups written by the current statement
+
+    // METHODS
+    AstNodeStmt* createMarks(FileLine* flp, const std::set<uint32_t>& groups) {
+        // Not a variable reference, so that the marks do not add dependencies for scheduling
+        AstNodeStmt* stmtsp = nullptr;
+        for (const uint32_t group : groups) {
+            const string text = "vlSymsp->TOP." + m_schedName + ".written(" + cvtToStr(group)
+                                + ");\n";
+            stmtsp = AstNode::addNext(stmtsp, static_cast<AstNodeStmt*>(new AstCStmt{flp, text}));
+        }
+        return stmtsp;
+    }
+    void written(const AstVar* varp) {
+        if (!m_groupsp) return;
+        const auto it = m_varGroups.find(varp);
+        if (it != m_varGroups.end()) m_groupsp->insert(it->second.begin(), it->second.end());
+    }
+
+    // VISITORS
+    void visit(AstNodeStmt* nodep) override {
+        std::set<uint32_t> groups;
+        {
+            VL_RESTORER(m_groupsp);
+            m_groupsp = &groups;
+            iterateChildren(nodep);
+        }
+        if (groups.empty()) return;
+        FileLine* const flp = nodep->fileline();
+        if (AstAssignW* const assignp = VN_CAST(nodep, AssignW)) {
+            // Make the continuous assignment an always, to have somewhere to put the marks. The
+            // always is iterated next, which marks the assignment in it.
+            assignp->convertToAlways();
+            VL_DO_DANGLING(assignp->deleteTree(), nodep);
+        } else if (AstWhile* const whilep = VN_CAST(nodep, While)) {
+            // Written by the condition, mark after every evaluation of it
+            if (whilep->stmtsp()) {
+                whilep->stmtsp()->addHereThisAsNext(createMarks(flp, groups));
+            } else {
+                whilep->addStmtsp(createMarks(flp, groups));
+            }
+            nodep->addNextHere(createMarks(flp, groups));
+        } else if (VN_IS(nodep, NodeIf) || VN_IS(nodep, NodeCase) || VN_IS(nodep, JumpGo)
+                   || VN_IS(nodep, CReturn)) {
+            // Written before branching, nothing can suspend in between, so mark before
+            nodep->addHereThisAsNext(createMarks(flp, groups));
+        } else {
+            // Mark after the statement, as it may suspend before writing
+            nodep->addNextHere(createMarks(flp, groups));
+        }
+    }
+    void visit(AstNodeVarRef* nodep) override {
+        if (nodep->access().isWriteOrRW()) written(nodep->varp());
+    }
+    void visit(AstMemberSel* nodep) override {
+        if (nodep->access().isWriteOrRW()) written(nodep->varp());
+        iterateChildren(nodep);
+    }
+
+    //--------------------
+    void visit(AstVar*) override {}  // Accelerate
+    void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    DynamicTriggerMarkVisitor(AstNetlist* nodep,
+                              const std::unordered_map<const AstVar*, std::set<uint32_t>>& varGroups,
+                              const string& schedName)
+        : m_varGroups{varGroups}
+        , m_schedName{schedName} {
+        iterate(nodep);
+    }
+    ~DynamicTriggerMarkVisitor() override = default;
+};
+
+// ######################################################################
+//  Find processes whose resumptions can run in parallel with each other
+
+class TimingParallelVisitor final : public VNVisitorConst {
+private:
+    // TYPES
+    struct Accesses final {
+        // Keyed by variable scope, as instances of a module share their AstVar
+        std::unordered_set<const AstVarScope*> m_reads;  // Variables read
+        std::unordered_set<const AstVarScope*> m_writes;  // Variables written
+    };
+
+    // STATE
+    // Candidate processes in tree order, with their accesses
+    std::vector<std::pair<const AstNodeProcedure*, Accesses>> m_candidates;
+    Accesses* m_accessesp = nullptr;  // Accesses of the current candidate, nullptr if none
+    bool m_eligible = false;  // The current candidate can still be resumed in parallel
+    bool m_clocked = false;  // Under an active with clocked sensitivities
+    std::unordered_set<const AstNodeProcedure*> m_procs;  // Processes resumed in parallel
+
+    // METHODS
+    static bool conflicts(const Accesses& a, const Accesses& b) {
+        for (const AstVarScope* const vscp : a.m_writes) {
+            if (b.m_reads.count(vscp) || b.m_writes.count(vscp)) return true;
+        }
+        for (const AstVarScope* const vscp : a.m_reads) {
+            if (b.m_writes.count(vscp)) return true;
+        }
+        return false;
+    }
+
+    // VISITORS
+    void visit(AstActive* nodep) override {
+        VL_RESTORER(m_clocked);
+        m_clocked = nodep->sensesp() && nodep->sensesp()->hasClocked();
+        iterateChildrenConst(nodep);
+    }
+    void visit(AstNodeProcedure* nodep) override {
+        // Only processes suspended by delays alone are candidates. Clocked always blocks wait
+        // for their events, and processes using 'std::process' can be controlled by others.
+        if (!(nodep->user2() & T_SUSPENDEE) || (nodep->user2() & T_HAS_PROC) || m_clocked) {
+            return;
+        }
+        Accesses accesses;
+        VL_RESTORER(m_accessesp);
+        VL_RESTORER(m_eligible);
+        m_accessesp = &accesses;
+        m_eligible = true;
+        iterateChildrenConst(nodep);
+        if (m_eligible) m_candidates.emplace_back(nodep, std::move(accesses));
+    }
+    void visit(AstNodeVarRef* nodep) override {
+        if (!m_accessesp) return;
+        const AstVarScope* const vscp = nodep->varScopep();
+        // Not scoped, e.g. class members, so cannot tell what is accessed
+        if (!vscp) {
+            m_eligible = false;
+            return;
+        }
+        if (nodep->access().isReadOrRW()) m_accessesp->m_reads.insert(vscp);
+        if (nodep->access().isWriteOrRW()) m_accessesp->m_writes.insert(vscp);
+    }
+    void visit(AstAssign* nodep) override {
+        if (nodep->timingControlp()) m_eligible = false;
+        iterateChildrenConst(nodep);
+    }
+    void visit(AstDelay* nodep) override {
+        if (nodep->isCycleDelay()) m_eligible = false;
+        iterateChildrenConst(nodep);
+    }
+    // Statements only touching the variables they reference
+    void visit(AstIf* nodep) override { iterateChildrenConst(nodep); }
+    void visit(AstWhile* nodep) override { iterateChildrenConst(nodep); }
+    void visit(AstJumpBlock* nodep) override { iterateChildrenConst(nodep); }
+    void visit(AstJumpGo* nodep) override { iterateChildrenConst(nodep); }
+    void visit(AstJumpLabel* nodep) override { iterateChildrenConst(nodep); }
+    void visit(AstComment*) override {}
+    void visit(AstNodeExpr* nodep) override {
+        // Calls and methods might access anything, impure expressions have side effects, and
+        // random numbers come from per thread state
+        if (!nodep->isPure() || VN_IS(nodep, NodeFTaskRef) || VN_IS(nodep, NodeCCall)
+            || VN_IS(nodep, CExpr) || VN_IS(nodep, CMethodHard) || VN_IS(nodep, MemberSel)
+            || VN_IS(nodep, Rand) || VN_IS(nodep, RandRNG) || VN_IS(nodep, URandomRange)) {
+            m_eligible = false;
+        }
+        iterateChildrenConst(nodep);
+    }
+    void visit(AstNode* nodep) override {
+        // Anything else, e.g. event controls, forks or system tasks, is resumed serially
+        if (m_accessesp) m_eligible = false;
+        iterateChildrenConst(nodep);
+    }
+
+    //--------------------
+    void visit(AstCFunc*) override {}  // Accelerate
+    void visit(AstVar*) override {}  // Accelerate
+
+public:
+    // CONSTRUCTORS
+    explicit TimingParallelVisitor(AstNetlist* nodep) {
+        iterateConst(nodep);
+        // Greedily take candidates independent of all taken so far. The others are resumed
+        // serially, so never run at the same time as these.
+        std::vector<const Accesses*> taken;
+        for (const auto& pair : m_candidates) {
+            const bool independent
+                = std::none_of(taken.begin(), taken.end(), [&](const Accesses* accessesp) {
+                      return conflicts(pair.second, *accessesp);
+                  });
+            if (!independent) continue;
+            m_procs.insert(pair.first);
+            taken.push_back(&pair.second);
+        }
+        // A single process has nothing to run in parallel with
+        if (m_procs.size() < 2) m_procs.clear();
+        V3Stats::addStat("Timing, parallel resumable processes", m_procs.size());
+    }
+    ~TimingParallelVisitor() override = default;
+
+    // ACCESSORS
+    const std::unordered_set<const AstNodeProcedure*>& procs() const { return m_procs; }
+};
+
 // ######################################################################
 //  Transform nodes affected by timing
 
@@ -407,6 +625,13 @@ private:
     AstSenTree* m_delaySensesp = nullptr;  // Domain to trigger if a delayed coroutine is resumed
     AstSenTree* m_dynamicSensesp = nullptr;  // Domain to trigger if a dynamic trigger is set
 
+    // Processes whose delays may be resumed in parallel (-ftiming-parallel)
+    std::unordered_set<const AstNodeProcedure*> m_parallelProcs;
+
+    // Dynamic trigger dependency groups (-ftiming-trigger-deps)
+    std::map<std::set<const AstVar*>, uint32_t> m_dynTrigGroups;  // Dependencies -> group
+    std::vector<std::vector<AstCMethodHard*>> m_dynTrigEvalps;  // Group -> evaluation calls
+
     // Other
     SenTreeFinder m_finder{m_netlistp};  // Sentree finder and uniquifier
     SenExprBuilder* m_senExprBuilderp = nullptr;  // Sens expression builder for current m_scope
@@ -524,6 +749,81 @@ private:
             return refp->varp()->isFuncLocal();
         });
     }
+    // Returns the dependency group of a dynamic trigger, or -1 if it must be evaluated on every
+    // trigger evaluation, as some of its inputs are not (only) written by Verilated code
+    int dynamicTriggerGroup(AstSenTree* const sensesp) {
+        if (!v3Global.opt.fTimingTriggerDeps()) return -1;
+        std::set<const AstVar*> deps;
+        bool tracked = true;
+        sensesp->foreach([&](const AstNode* const nodep) {
+            if (const AstNodeVarRef* const refp = VN_CAST(nodep, NodeVarRef)) {
+                deps.insert(refp->varp());
+            } else if (const AstMemberSel* const selp = VN_CAST(nodep, MemberSel)) {
+                deps.insert(selp->varp());
+            } else if (VN_IS(nodep, NodeFTaskRef) || VN_IS(nodep, NodeCCall)
+                       || VN_IS(nodep, CExpr) || VN_IS(nodep, Time) || VN_IS(nodep, TimeD)
+                       || !nodep->isPure()) {
+                tracked = false;
+            } else if (const AstCMethodHard* const methodp = VN_CAST(nodep, CMethodHard)) {
+                // The 'triggered' state of events is cleared by the runtime
+                if (methodp->name() == "isTriggered") tracked = false;
+            }
+        });
+        for (const AstVar* const varp : deps) {
+            if (varp->isIO() || varp->isSigPublic() || varp->isSigUserRWPublic()
+                || varp->isWrittenByDpi() || varp->isForceable()) {
+                tracked = false;
+            }
+        }
+        if (!tracked || deps.empty()) return -1;
+        const auto pair = m_dynTrigGroups.emplace(deps, m_dynTrigGroups.size());
+        if (pair.second) m_dynTrigEvalps.emplace_back();
+        return pair.first->second;
+    }
+    // Mark dynamic trigger dependency groups dirty wherever their variables are written
+    void createDynamicTriggerMarks() {
+        if (m_dynTrigGroups.empty()) return;
+        std::unordered_map<const AstVar*, std::set<uint32_t>> varGroups;
+        for (const auto& pair : m_dynTrigGroups) {
+            for (const AstVar* const varp : pair.first) varGroups[varp].insert(pair.second);
+        }
+        // Writes through task arguments and aliases are not seen where the variable is written,
+        // and delayed writes are only committed later by the scheduler, evaluate the triggers
+        // depending on these variables every time instead
+        std::set<uint32_t> untracked;
+        const auto untrackWrites = [&](AstNode* const nodep) {
+            nodep->foreach([&](const AstNode* const subp) {
+                const AstVar* varp = nullptr;
+                if (const AstNodeVarRef* const refp = VN_CAST(subp, NodeVarRef)) {
+                    if (refp->access().isWriteOrRW()) varp = refp->varp();
+                } else if (const AstMemberSel* const selp = VN_CAST(subp, MemberSel)) {
+                    if (selp->access().isWriteOrRW()) varp = selp->varp();
+                }
+                const auto it = varGroups.find(varp);
+                if (it != varGroups.end()) untracked.insert(it->second.begin(), it->second.end());
+            });
+        };
+        m_netlistp->foreach([&](AstNodeCCall* const callp) { untrackWrites(callp); });
+        m_netlistp->foreach([&](AstNodeFTaskRef* const refp) { untrackWrites(refp); });
+        m_netlistp->foreach([&](AstAssignDly* const assignp) { untrackWrites(assignp); });
+        m_netlistp->foreach([&](AstAssignAlias* const assignp) { untrackWrites(assignp); });
+        m_netlistp->foreach([&](AstAssignVarScope* const assignp) { untrackWrites(assignp); });
+        for (const uint32_t group : untracked) {
+            for (AstCMethodHard* const evalp : m_dynTrigEvalps[group]) {
+                evalp->name("evaluation");
+                evalp->pinsp()->nextp()->unlinkFrBack()->deleteTree();
+            }
+        }
+        for (auto it = varGroups.begin(); it != varGroups.end();) {
+            for (const uint32_t group : untracked) it->second.erase(group);
+            it = it->second.empty() ? varGroups.erase(it) : std::next(it);
+        }
+        if (untracked.size() == m_dynTrigGroups.size()) return;
+        const string schedName = getCreateDynamicTriggerScheduler()->varp()->nameProtect();
+        { DynamicTriggerMarkVisitor{m_netlistp, varGroups, schedName}; }
+        V3Stats::addStat("Timing, dynamic trigger dependency groups",
+                         m_dynTrigGroups.size() - untracked.size());
+    }
     // Returns true if the given trigger expression needs a destructive post update after trigger
     // evaluation. Currently this only applies to named events.
     bool destructivePostUpdate(AstNode* const exprp) const {
@@ -781,8 +1081,10 @@ private:
             }
         }
         // Replace self with a 'co_await dlySched.delay(<valuep>)'
+        const bool parallel = m_parallelProcs.count(VN_CAST(m_procp, NodeProcedure));
         auto* const delayMethodp = new AstCMethodHard{
-            flp, new AstVarRef{flp, getCreateDelayScheduler(), VAccess::WRITE}, "delay", valuep};
+            flp, new AstVarRef{flp, getCreateDelayScheduler(), VAccess::WRITE},
+            parallel ? "delayParallel" : "delay", valuep};
         delayMethodp->dtypeSetVoid();
         addProcessInfo(delayMethodp);
         addDebugInfo(delayMethodp);
@@ -827,6 +1129,7 @@ private:
             addProcessInfo(evalMethodp);
             auto* const sensesp = nodep->sensesp();
             addEventDebugInfo(evalMethodp, sensesp);
+            const int group = dynamicTriggerGroup(sensesp);
             // Create the co_await
             AstCAwait* const awaitEvalp
                 = new AstCAwait{flp, evalMethodp, getCreateDynamicTriggerSenTree()};
@@ -868,6 +1171,14 @@ private:
             AstCAwait* const awaitResumep = awaitEvalp->cloneTree(false);
             VN_AS(awaitResumep->exprp(), CMethodHard)->name("resumption");
             AstNode::addNext<AstNodeStmt, AstNodeStmt>(loopp, awaitResumep->makeStmt());
+            // If the trigger depends only on known variables, await evaluation after they are
+            // written
+            if (group >= 0) {
+                evalMethodp->name("dependentEvaluation");
+                evalMethodp->pinsp()->addNextHere(
+                    new AstConst{flp, AstConst::Unsized32{}, static_cast<uint32_t>(group)});
+                m_dynTrigEvalps[group].push_back(evalMethodp);
+            }
             // Replace the event control with the loop
             nodep->replaceWith(loopp);
         } else {
@@ -1060,7 +1371,11 @@ public:
     // CONSTRUCTORS
     explicit TimingControlVisitor(AstNetlist* nodep)
         : m_netlistp{nodep} {
+        if (v3Global.opt.fTimingParallel() && v3Global.opt.mtasks()) {
+            m_parallelProcs = TimingParallelVisitor{nodep}.procs();
+        }
         iterate(nodep);
+        createDynamicTriggerMarks();
     }
     ~TimingControlVisitor() override = default;
 };
@@ -183,7 +183,7 @@ private:
     TraceActivityVertex* const m_alwaysVtxp;  // "Always trace" vertex
     bool m_finding = false;  // Pass one of algorithm?
 
-    // Trace parallelism. Only VCD tracing can be parallelized at this time.
+    // Trace parallelism. Offloaded FST tracing cannot be parallelized at this time.
     const uint32_t m_parallelism
         = v3Global.opt.useTraceParallel() ? static_cast<uint32_t>(v3Global.opt.threads()) : 1;
 
@@ -17,6 +17,8 @@
 //
 // Each module:
 //   Order module variables
+//   With --threads-var-layout, group variables by the thread writing them,
+//   each group starting on a new cache line
 //
 //*************************************************************************
 
@@ -29,9 +31,15 @@
 #include "V3AstUserAllocator.h"
 #include "V3EmitCBase.h"
 #include "V3Global.h"
+#include "V3PartitionGraph.h"
+#include "V3Stats.h"
 #include "V3TSP.h"
 
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -78,11 +86,94 @@ public:
 
 unsigned VarTspSorter::s_serialNext = 0;
 
+//######################################################################
+// Thread ownership of mtasks, for laying out variables by thread
+
+class VarThreadLayout final {
+public:
+    // TYPES
+    using ThreadSet = std::set<uint32_t>;
+
+    // MEMBERS
+    std::unordered_map<int, uint32_t> m_mtaskThread;  // Static thread of each mtask ID
+    VDouble0 m_statSharedLinesBefore;  // Cross-thread shared cache lines before
+    VDouble0 m_statSharedLinesAfter;  // Cross-thread shared cache lines after
+    VDouble0 m_statReadMostly;  // Variables read by mtasks but written by none
+
+    // CONSTRUCTORS
+    explicit VarThreadLayout(AstNetlist* netlistp) {
+        netlistp->topModulep()->foreach([this](const AstExecGraph* execGraphp) {
+            for (const V3GraphVertex* vxp = execGraphp->depGraphp()->verticesBeginp(); vxp;
+                 vxp = vxp->verticesNextp()) {
+                const ExecMTask* const mtaskp = static_cast<const ExecMTask*>(vxp);
+                m_mtaskThread.emplace(mtaskp->id(), mtaskp->threadId());
+            }
+        });
+    }
+    ~VarThreadLayout() {
+        V3Stats::addStat("Var layout, cross-thread shared cache lines before",
+                         m_statSharedLinesBefore);
+        V3Stats::addStat("Var layout, cross-thread shared cache lines after",
+                         m_statSharedLinesAfter);
+        V3Stats::addStat("Var layout, read-mostly variables", m_statReadMostly);
+    }
+
+    // METHODS
+    ThreadSet threads(const MTaskIdSet& mtaskIds) const {
+        ThreadSet result;
+        for (const int id : mtaskIds) {
+            const auto it = m_mtaskThread.find(id);
+            if (it != m_mtaskThread.end()) result.insert(it->second);
+        }
+        return result;
+    }
+
+    // Estimate the number of cache lines that are written by one thread and
+    // accessed by another, if the variables are laid out in the given order
+    uint64_t sharedLines(const std::vector<AstVar*>& varps) const {
+        // Cache line -> (writing threads, accessing threads)
+        std::map<uint64_t, std::pair<ThreadSet, ThreadSet>> lines;
+        uint64_t offset = 0;
+        for (const AstVar* const varp : varps) {
+            if (varp->isStatic()) continue;
+            const AstNodeDType* const dtypep = varp->dtypeSkipRefp();
+            const uint64_t size = std::max(dtypep->widthTotalBytes(), 1);
+            const uint64_t align = varp->alignCacheLine()
+                                       ? VL_CACHE_LINE_BYTES
+                                       : std::min(std::max(dtypep->widthAlignBytes(), 1), 8);
+            offset = (offset + align - 1) / align * align;
+            const ThreadSet accessors = threads(varp->mtaskIds());
+            if (!accessors.empty()) {
+                const ThreadSet writers = threads(varp->producingMTaskIds());
+                const uint64_t lastLine = (offset + size - 1) / VL_CACHE_LINE_BYTES;
+                for (uint64_t line = offset / VL_CACHE_LINE_BYTES; line <= lastLine; ++line) {
+                    auto& pair = lines[line];
+                    pair.first.insert(writers.begin(), writers.end());
+                    pair.second.insert(accessors.begin(), accessors.end());
+                }
+            }
+            offset += size;
+        }
+        uint64_t count = 0;
+        for (const auto& it : lines) {
+            const ThreadSet& writers = it.second.first;
+            const ThreadSet& accessors = it.second.second;
+            if (writers.empty()) continue;
+            if (writers.size() > 1 || accessors.size() > 1) ++count;
+        }
+        return count;
+    }
+};
+
+//######################################################################
+
 class VariableOrder final {
     // NODE STATE
     //  AstVar::user1()    -> attributes, via m_attributes
     const VNUser1InUse m_user1InUse;  // AstVar
 
+    VarThreadLayout* const m_layoutp;  // Thread ownership, or nullptr if not laying out by thread
+
     struct VarAttributes {
         uint32_t stratum;  // Roughly equivalent to alignment requirement, to avoid padding
         bool anonOk;  // Can be emitted as part of anonymous structure
@@ -144,6 +235,40 @@ class VariableOrder final {
         sortAndAppend(m2v[MTaskIdSet()]);
     }
 
+    // Group by writing thread, each group on its own cache lines, then the same as tspSortVars
+    void threadSortVars(std::vector<AstVar*>& varps) {
+        // Groups are ordered: read-mostly (no mtask writes it), written by a
+        // single thread in thread order, written by multiple threads, and
+        // finally no known MTask affinity
+        constexpr uint32_t GROUP_READ_MOSTLY = 0;
+        constexpr uint32_t GROUP_MULTI_WRITER = 0xfffffffeU;
+        constexpr uint32_t GROUP_NONE = 0xffffffffU;
+        std::map<uint32_t, std::vector<AstVar*>> groups;
+        for (AstVar* const varp : varps) {
+            const VarThreadLayout::ThreadSet writers
+                = m_layoutp->threads(varp->producingMTaskIds());
+            const uint32_t group = varp->mtaskIds().empty() ? GROUP_NONE
+                                   : writers.empty()        ? GROUP_READ_MOSTLY
+                                   : writers.size() > 1     ? GROUP_MULTI_WRITER
+                                                            : *writers.begin() + 1;
+            groups[group].push_back(varp);
+            if (group == GROUP_READ_MOSTLY) ++m_layoutp->m_statReadMostly;
+        }
+
+        varps.clear();
+        for (auto& pair : groups) {
+            std::vector<AstVar*>& subVarps = pair.second;
+            tspSortVars(subVarps);
+            if (groups.size() > 1) {
+                // Statics are not part of the object, so align the first non-static
+                const auto it = std::find_if(subVarps.begin(), subVarps.end(),
+                                             [](const AstVar* varp) { return !varp->isStatic(); });
+                if (it != subVarps.end()) (*it)->alignCacheLine(true);
+            }
+            varps.insert(varps.end(), subVarps.begin(), subVarps.end());
+        }
+    }
+
     void orderModuleVars(AstNodeModule* modp) {
         std::vector<AstVar*> varps;
 
@@ -177,8 +302,17 @@ class VariableOrder final {
             // Sort variables
             if (!v3Global.opt.mtasks()) {
                 simpleSortVars(varps);
-            } else {
+            } else if (!m_layoutp || VN_IS(modp, Class)) {
                 tspSortVars(varps);
+            } else {
+                if (v3Global.opt.stats()) {
+                    tspSortVars(varps);
+                    m_layoutp->m_statSharedLinesBefore += m_layoutp->sharedLines(varps);
+                }
+                threadSortVars(varps);
+                if (v3Global.opt.stats()) {
+                    m_layoutp->m_statSharedLinesAfter += m_layoutp->sharedLines(varps);
+                }
             }
 
             // Insert them back under the module, in the new order, but at
@@ -194,8 +328,14 @@ class VariableOrder final {
         }
     }
 
+    // CONSTRUCTORS
+    explicit VariableOrder(VarThreadLayout* layoutp)
+        : m_layoutp{layoutp} {}
+
 public:
-    static void processModule(AstNodeModule* modp) { VariableOrder{}.orderModuleVars(modp); }
+    static void processModule(AstNodeModule* modp, VarThreadLayout* layoutp) {
+        VariableOrder{layoutp}.orderModuleVars(modp);
+    }
 };
 
 //######################################################################
@@ -203,9 +343,16 @@ public:
 
 void V3VariableOrder::orderAll() {
     UINFO(2, __FUNCTION__ << ": " << endl);
+    // Thread ownership is only known with a static schedule
+    std::unique_ptr<VarThreadLayout> layoutp;
+    if (v3Global.opt.mtasks() && v3Global.opt.threadsVarLayout()
+        && !v3Global.opt.threadsDynamic()) {
+        layoutp.reset(new VarThreadLayout{v3Global.rootp()});
+    }
     for (AstNodeModule* modp = v3Global.rootp()->modulesp(); modp;
          modp = VN_AS(modp->nextp(), NodeModule)) {
-        VariableOrder::processModule(modp);
+        VariableOrder::processModule(modp, layoutp.get());
     }
+    layoutp.reset();
     V3Global::dumpCheckGlobalTree("variableorder", 0, dumpTreeLevel() >= 3);
 }
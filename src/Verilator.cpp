@@ -631,6 +631,9 @@ static void verilate(const string& argString) {
         V3ThreadPool::selfTest();
         UINFO(2, "selfTest done\n");
     }
+    if (v3Global.opt.debugPartitionBenchmark()) {
+        V3Partition::benchmark(v3Global.opt.debugPartitionBenchmark());
+    }
 
     // Read first filename
     v3Global.readFiles();
@@ -934,9 +934,12 @@ sub compile_vlt_flags {
     $self->{sc} = 1 if ($checkflags =~ /-sc\b/);
     $self->{timing} = 1 if ($checkflags =~ / -?-timing\b/ || $checkflags =~ / -?-binary\b/ );
     $self->{trace} = ($opt_trace || $checkflags =~ /-trace\b/
-                      || $checkflags =~ /-trace-fst\b/);
+                      || $checkflags =~ /-trace-fst\b/
+                      || $checkflags =~ /-trace-bin\b/);
     $self->{trace_format} = (($checkflags =~ /-trace-fst/ && $self->{sc} && 'fst-sc')
                              || ($checkflags =~ /-trace-fst/ && !$self->{sc} && 'fst-c')
+                             || ($checkflags =~ /-trace-bin/ && $self->{sc} && 'bin-sc')
+                             || ($checkflags =~ /-trace-bin/ && !$self->{sc} && 'bin-c')
                              || ($self->{sc} && 'vcd-sc')
                              || (!$self->{sc} && 'vcd-c'));
     $self->{sanitize} = $opt_sanitize unless exists($self->{sanitize});
@@ -1538,6 +1541,7 @@ sub cmake_version {
 sub trace_filename {
     my $self = shift;
     return "$self->{obj_dir}/simx.fst" if $self->{trace_format} =~ /^fst/;
+    return "$self->{obj_dir}/simx.bin" if $self->{trace_format} =~ /^bin/;
     return "$self->{obj_dir}/simx.vcd";
 }
 
@@ -1803,6 +1807,8 @@ sub _make_main {
     print $fh "#include \"verilated_fst_sc.h\"\n" if $self->{trace} && $self->{trace_format} eq 'fst-sc';
     print $fh "#include \"verilated_vcd_c.h\"\n" if $self->{trace} && $self->{trace_format} eq 'vcd-c';
     print $fh "#include \"verilated_vcd_sc.h\"\n" if $self->{trace} && $self->{trace_format} eq 'vcd-sc';
+    print $fh "#include \"verilated_bin_c.h\"\n" if $self->{trace} && $self->{trace_format} eq 'bin-c';
+    print $fh "#include \"verilated_bin_sc.h\"\n" if $self->{trace} && $self->{trace_format} eq 'bin-sc';
     print $fh "#include \"verilated_save.h\"\n" if $self->{savable};
 
     print $fh "std::unique_ptr<${vm_prefix}> topp;\n";
@@ -1873,6 +1879,8 @@ sub _make_main {
         $fh->print("    std::unique_ptr<VerilatedFstSc> tfp{new VerilatedFstSc};\n") if $self->{trace_format} eq 'fst-sc';
         $fh->print("    std::unique_ptr<VerilatedVcdC> tfp{new VerilatedVcdC};\n") if $self->{trace_format} eq 'vcd-c';
         $fh->print("    std::unique_ptr<VerilatedVcdSc> tfp{new VerilatedVcdSc};\n") if $self->{trace_format} eq 'vcd-sc';
+        $fh->print("    std::unique_ptr<VerilatedBinC> tfp{new VerilatedBinC};\n") if $self->{trace_format} eq 'bin-c';
+        $fh->print("    std::unique_ptr<VerilatedBinSc> tfp{new VerilatedBinSc};\n") if $self->{trace_format} eq 'bin-sc';
         $fh->print("    sc_core::sc_start(sc_core::SC_ZERO_TIME);  // Finish elaboration before trace and open\n") if $self->sc;
         $fh->print("    topp->trace(tfp.get(), 99);\n");
         $fh->print("    tfp->open(\"" . $self->trace_filename . "\");\n");
@@ -0,0 +1,38 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+compile(
+    verilator_flags2 => ["--activity-gating --prof-exec --stats"],
+    );
+
+file_grep($Self->{stats}, qr/Scheduling, activity gated functions\s+([1-9]\d*)/i);
+
+execute(
+    all_run_flags => ["+verilator+prof+exec+start+2",
+                      " +verilator+prof+exec+window+40",
+                      " +verilator+prof+exec+file+$Self->{obj_dir}/profile_exec.dat",
+                      ],
+    check_finished => 1,
+    );
+
+file_grep("$Self->{obj_dir}/profile_exec.dat", qr/VLPROF stat gate-skips [1-9]/);
+
+run(cmd => ["$ENV{VERILATOR_ROOT}/bin/verilator_gantt",
+            "$Self->{obj_dir}/profile_exec.dat",
+            "--no-vcd",
+            "| tee $Self->{obj_dir}/gantt.log"],
+    );
+
+file_grep("$Self->{obj_dir}/gantt.log", qr/Activity gated skip rate +=/i);
+
+ok(1);
+1;
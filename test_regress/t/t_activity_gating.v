@@ -0,0 +1,54 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Outputs
+   mix,
+   // Inputs
+   clk
+   );
+   input clk;
+   output logic [31:0] mix;
+
+   integer cyc = 0;
+   logic [31:0] a_q = 32'h1234_5678;
+   logic [31:0] b_q = 32'h9abc_def0;
+   logic [31:0] sum = 0;
+
+   // Inputs only change every 8th cycle, so this should be skipped mostly
+   always_comb begin
+      mix = a_q ^ (b_q << 3);
+      mix = mix + (mix >> 7) * 3;
+      mix = mix ^ {mix[15:0], mix[31:16]};
+      mix = mix - (b_q >> 5);
+   end
+
+   function automatic logic [31:0] expected(logic [31:0] a, logic [31:0] b);
+      logic [31:0] m;
+      m = a ^ (b << 3);
+      m = m + (m >> 7) * 3;
+      m = m ^ {m[15:0], m[31:16]};
+      m = m - (b >> 5);
+      return m;
+   endfunction
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (mix !== expected(a_q, b_q)) begin
+         $write("%%Error: cyc=%0d mix=%x exp=%x\n", cyc, mix, expected(a_q, b_q));
+         $stop;
+      end
+      sum <= sum + mix;
+      if (cyc[2:0] == 3'd7) begin
+         a_q <= a_q + 32'h0101_0101;
+         b_q <= {b_q[30:0], b_q[31]};
+      end
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
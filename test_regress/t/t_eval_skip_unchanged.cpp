@@ -0,0 +1,69 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Skipping evaluation, --eval-skip-unchanged
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+
+#include <iostream>
+#include <memory>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include "Vt_eval_skip_unchanged.h"
+
+double sc_time_stamp() { return 0; }
+
+int errors = 0;
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<Vt_eval_skip_unchanged> topp{
+        new Vt_eval_skip_unchanged{contextp.get(), "top"}};
+
+    topp->clk = 0;
+    topp->a = 3;
+    topp->r = 1.5;
+    topp->eval();
+    TEST_CHECK_EQ(topp->evalsSkipped(), 0);
+    TEST_CHECK_EQ(topp->doubled, 6);
+    TEST_CHECK_EQ(topp->scaled, 15);
+
+    // Nothing changed
+    for (int i = 0; i < 10; ++i) topp->eval();
+    TEST_CHECK_EQ(topp->evalsSkipped(), 10);
+    TEST_CHECK_EQ(topp->count, 0);
+
+    // Each input change is evaluated, then repeats are skipped
+    topp->a = 200;
+    topp->eval();
+    topp->eval();
+    TEST_CHECK_EQ(topp->doubled, 400);
+    TEST_CHECK_EQ(topp->evalsSkipped(), 11);
+    topp->r = 2.5;
+    topp->eval();
+    topp->eval();
+    TEST_CHECK_EQ(topp->scaled, 25);
+    TEST_CHECK_EQ(topp->evalsSkipped(), 12);
+
+    // Clock edges are evaluated, a second call at the same level is not
+    for (int cyc = 0; cyc < 5; ++cyc) {
+        topp->clk = 1;
+        topp->eval();
+        topp->eval();
+        topp->clk = 0;
+        topp->eval();
+    }
+    TEST_CHECK_EQ(topp->count, 5);
+    TEST_CHECK_EQ(topp->evalsSkipped(), 17);
+
+    topp->final();
+    if (!errors) std::cout << "*-* All Finished *-*" << std::endl;
+    return errors ? 10 : 0;
+}
@@ -0,0 +1,24 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Outputs
+   count, doubled, scaled,
+   // Inputs
+   clk, a, r
+   );
+   input clk;
+   input [7:0] a;
+   input real r;
+   output logic [31:0] count = 0;
+   output logic [8:0] doubled;
+   output int scaled;
+
+   always @(posedge clk) count <= count + 1;
+
+   assign doubled = {a, 1'b0};
+   assign scaled = int'(r * 10.0);
+endmodule
@@ -37,6 +37,7 @@ check("python3", "../bin/verilator_ccache_report");
 check("python3", "../bin/verilator_difftree");
 check("python3", "../bin/verilator_gantt");
 check("python3", "../bin/verilator_profcfunc");
+check("python3", "../bin/verilator_trace_convert");
 
 ok(1);
 1;
@@ -0,0 +1,61 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Multi-cycle evaluation, --run-cycles
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+
+#include <iostream>
+#include <memory>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include "Vt_run_cycles.h"
+
+double sc_time_stamp() { return 0; }
+
+int errors = 0;
+
+struct CallbackData {
+    Vt_run_cycles* topp;
+    int calls;
+};
+
+static void callback(void* userp) {
+    CallbackData& data = *static_cast<CallbackData*>(userp);
+    ++data.calls;
+    TEST_CHECK_EQ(data.topp->count, 10 * data.calls);
+}
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<Vt_run_cycles> topp{new Vt_run_cycles{contextp.get(), "top"}};
+
+    topp->clk = 0;
+    topp->step = 1;
+    topp->eval();
+
+    CallbackData data{topp.get(), 0};
+    TEST_CHECK_EQ(topp->runCycles(100, 1, 10, callback, &data), 100);
+    TEST_CHECK_EQ(data.calls, 10);
+    TEST_CHECK_EQ(topp->count, 100);
+    TEST_CHECK_EQ(contextp->time(), 200);
+
+    topp->step = 2;
+    TEST_CHECK_EQ(topp->runCycles(50, 5), 50);
+    TEST_CHECK_EQ(topp->count, 200);
+    TEST_CHECK_EQ(contextp->time(), 700);
+
+    // $finish on the 200th rising edge, during the 50th cycle of this call
+    TEST_CHECK_EQ(topp->runCycles(1000), 49);
+    TEST_CHECK_EQ(contextp->gotFinish(), true);
+
+    topp->final();
+    return errors ? 10 : 0;
+}
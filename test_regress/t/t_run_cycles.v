@@ -0,0 +1,27 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Outputs
+   count,
+   // Inputs
+   clk, step
+   );
+   input clk;
+   input [7:0] step;
+   output logic [31:0] count = 0;
+
+   int cyc = 0;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      count <= count + step;
+      if (cyc == 199) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
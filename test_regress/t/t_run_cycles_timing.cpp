@@ -0,0 +1,63 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Multi-cycle evaluation, --run-cycles with --timing
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+
+#include <iostream>
+#include <memory>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include "Vt_run_cycles_timing.h"
+
+double sc_time_stamp() { return 0; }
+
+int errors = 0;
+
+struct CallbackData {
+    Vt_run_cycles_timing* topp;
+    int calls;
+};
+
+static void callback(void* userp) {
+    CallbackData& data = *static_cast<CallbackData*>(userp);
+    ++data.calls;
+    TEST_CHECK_EQ(data.topp->count, 10 * data.calls);
+    // The delay after each rising edge ended before the next edge
+    TEST_CHECK_EQ(data.topp->delayed, 10 * data.calls);
+    TEST_CHECK_EQ(data.topp->high, 10 * data.calls);
+}
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<Vt_run_cycles_timing> topp{
+        new Vt_run_cycles_timing{contextp.get(), "top"}};
+
+    topp->clk = 0;
+    topp->step = 1;
+    topp->eval();
+
+    // Edges 5 time units apart, the #3 delay ends between them
+    CallbackData data{topp.get(), 0};
+    TEST_CHECK_EQ(topp->runCycles(100, 5, 10, callback, &data), 100);
+    TEST_CHECK_EQ(data.calls, 10);
+    TEST_CHECK_EQ(topp->count, 100);
+    TEST_CHECK_EQ(topp->delayed, 100);
+    TEST_CHECK_EQ(topp->high, 100);
+    TEST_CHECK_EQ(contextp->time(), 1000);
+
+    // $finish on the 200th rising edge, during the 100th cycle of this call
+    TEST_CHECK_EQ(topp->runCycles(1000, 5), 99);
+    TEST_CHECK_EQ(contextp->gotFinish(), true);
+
+    topp->final();
+    return errors ? 10 : 0;
+}
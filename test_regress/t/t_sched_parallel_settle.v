@@ -0,0 +1,67 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   logic [31:0] seed[4];
+   initial begin
+      seed[0] = 32'h1;
+      seed[1] = 32'h12;
+      seed[2] = 32'h123;
+      seed[3] = 32'h1234;
+   end
+
+   wire [31:0] result[4];
+   for (genvar i = 0; i < 4; ++i) begin : gen
+      sub sub(.in(seed[i]), .out(result[i]));
+   end
+
+   wire [31:0] total = result[0] ^ result[1] ^ result[2] ^ result[3];
+
+   int cyc = 0;
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 0) begin
+`ifdef TEST_VERBOSE
+         $display("total=%x", total);
+`endif
+         for (int i = 0; i < 4; ++i) begin
+            if (result[i] != sub_model(seed[i])) $stop;
+         end
+      end
+      else if (cyc == 1) begin
+         seed[2] <= 32'h4321;
+      end
+      else if (cyc == 2) begin
+         if (result[2] != sub_model(32'h4321)) $stop;
+         if (total != (result[0] ^ result[1] ^ sub_model(32'h4321) ^ result[3])) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   function automatic logic [31:0] sub_model(logic [31:0] in);
+      logic [31:0] x = in;
+      for (int i = 0; i < 8; ++i) x = {x[30:0], x[31] ^ x[21] ^ x[1] ^ x[0]} + 32'h9e3779b9;
+      return x;
+   endfunction
+endmodule
+
+module sub (
+   input [31:0] in,
+   output [31:0] out
+   );
+   wire [31:0] x[9];
+   assign x[0] = in;
+   for (genvar i = 0; i < 8; ++i) begin : stage
+      assign x[i + 1] = {x[i][30:0], x[i][31] ^ x[i][21] ^ x[i][1] ^ x[i][0]} + 32'h9e3779b9;
+   end
+   assign out = x[8];
+endmodule
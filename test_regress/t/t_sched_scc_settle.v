@@ -0,0 +1,41 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   logic [7:0] a = 8'h5a;
+   logic [7:0] b = 8'h3c;
+
+   // Ripple carry adder with all carries in one vector, which is a false
+   // combinational loop through 'c', taking up to 8 iterations to settle
+   /* verilator lint_off UNOPTFLAT */
+   wire [8:0] c;
+   /* verilator lint_on UNOPTFLAT */
+   wire [7:0] s;
+   assign c[0] = 1'b0;
+   assign c[8:1] = (a & b) | (a & c[7:0]) | (b & c[7:0]);
+   assign s = a ^ b ^ c[7:0];
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      a <= a * 8'd13 + 8'd7;
+      b <= b ^ {b[6:0], b[7]} ^ cyc[7:0];
+      if ({c[8], s} != {1'b0, a} + {1'b0, b}) begin
+         $write("%%Error: %x + %x = %x, expected %x\n", a, b, {c[8], s}, {1'b0, a} + {1'b0, b});
+         $stop;
+      end
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
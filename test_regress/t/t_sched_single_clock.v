@@ -0,0 +1,42 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   logic [63:0] crc = 64'h5aef0c8d_d70a4497;
+   logic [63:0] sum = '0;
+
+   // Combinational logic of the input, must be settled before the clock edge
+   logic [1:0] phase;
+   always_comb phase = {clk, ~clk};
+
+   // Combinational logic of the state, must be settled after the clock edge
+   wire [63:0] mix = crc ^ {crc[31:0], crc[63:32]};
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      sum <= sum + mix;
+      if (phase != 2'b10) begin
+         $write("%%Error: phase %b\n", phase);
+         $stop;
+      end
+      if (cyc == 99) begin
+         if (crc !== 64'h8ef77366_f09d4122 || sum !== 64'hf084ea28_f084e9f4) begin
+            $write("%%Error: crc %x sum %x\n", crc, sum);
+            $stop;
+         end
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,45 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vltmt => 1);
+
+top_filename("t/t_threads_schedule_dynamic.v");
+
+compile(
+    verilator_flags2 => ["--prof-exec"],
+    threads => 4,
+    );
+
+foreach my $affinity ("0", "numa") {
+    execute(
+        all_run_flags => ["+verilator+threads+affinity+$affinity",
+                          " +verilator+prof+exec+file+$Self->{obj_dir}/profile_exec_$affinity.dat"],
+        check_finished => 1,
+        );
+    file_grep("$Self->{obj_dir}/profile_exec_$affinity.dat", qr/VLPROF stat pinned [01]/);
+    file_grep("$Self->{obj_dir}/profile_exec_$affinity.dat", qr/VLPROF stat evals [1-9]/);
+    file_grep("$Self->{obj_dir}/profile_exec_$affinity.dat", qr/VLPROF stat seconds [0-9.]+/);
+}
+
+execute(
+    all_run_flags => ["+verilator+threads+affinity+bogus"],
+    fails => 1,
+    expect => qr/Unknown \+verilator\+threads\+affinity\+ value: 'bogus'/,
+    );
+
+# Only has CPU list characters, but is not a list
+execute(
+    all_run_flags => ["+verilator+threads+affinity+3-"],
+    fails => 1,
+    expect => qr/Unknown \+verilator\+threads\+affinity\+ value: '3-'/,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,81 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Microbenchmark of VlWorkerThread task dispatch
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_threads.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include VM_PREFIX_INCLUDE
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+double sc_time_stamp() { return 0; }
+
+int errors = 0;
+
+#ifdef TEST_BENCHMARK
+static constexpr uint64_t ITERATIONS = 1000000ULL * TEST_BENCHMARK;
+#else
+static constexpr uint64_t ITERATIONS = 2000;
+#endif
+
+static void setFlag(void* flagp, bool) {
+    static_cast<std::atomic<bool>*>(flagp)->store(true, std::memory_order_release);
+}
+
+static void countTask(void* countp, bool) {
+    static_cast<std::atomic<uint64_t>*>(countp)->fetch_add(1, std::memory_order_relaxed);
+}
+
+int main(int argc, char** argv, char** env) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->threads(2);
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+
+    VlThreadPool* const poolp = static_cast<VlThreadPool*>(contextp->threadPoolp());
+    if (!poolp) {
+        printf("%%Error: no thread pool\n");
+        return 10;
+    }
+    VlWorkerThread* const workerp = poolp->workerp(0);
+
+    // Round trip: hand a task to the worker and wait until it has run
+    std::atomic<bool> flag{false};
+    const auto rtBegin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < ITERATIONS; ++i) {
+        workerp->addTask(setFlag, &flag);
+        while (!flag.load(std::memory_order_acquire)) std::this_thread::yield();
+        flag.store(false, std::memory_order_relaxed);
+    }
+    const auto rtEnd = std::chrono::steady_clock::now();
+
+    // Throughput: enqueue a stream of tasks, then wait for all of them
+    std::atomic<uint64_t> count{0};
+    const auto tpBegin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < ITERATIONS; ++i) workerp->addTask(countTask, &count);
+    workerp->wait();
+    const auto tpEnd = std::chrono::steady_clock::now();
+    TEST_CHECK_EQ(count.load(), ITERATIONS);
+
+    const double rtNs = std::chrono::duration<double, std::nano>(rtEnd - rtBegin).count();
+    const double tpNs = std::chrono::duration<double, std::nano>(tpEnd - tpBegin).count();
+    printf("Dispatch latency: %.0f ns/task round trip, %.0f ns/task streamed\n",
+           rtNs / ITERATIONS, tpNs / ITERATIONS);
+
+    topp->final();
+    if (!errors) printf("*-* All Finished *-*\n");
+    return errors ? 10 : 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+# Merges must not lower the scores of other merge candidates sharing data
+# with the merged mtasks, which the partitioner's checks would catch
+scenarios(vltmt => 1);
+
+compile(
+    verilator_flags2 => ["--threads-footprint-weight 64 --debug-check"],
+    threads => 4,
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,74 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Many mtasks reading the same wide arrays, so merging them changes the
+// data footprint shared with the other mtasks.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   localparam LANES = 12;
+   localparam ENTRIES = 16;
+
+   integer cyc = 0;
+
+   logic [511:0] tbl_a [ENTRIES];
+   logic [511:0] tbl_b [ENTRIES];
+   logic [63:0] lane_d [LANES];
+
+   initial begin
+      for (int i = 0; i < ENTRIES; ++i) begin
+         tbl_a[i] = {16{32'(i) * 32'h9e37_79b9}};
+         tbl_b[i] = {16{32'(i) ^ 32'h5a5a_a5a5}};
+      end
+   end
+
+   function automatic logic [63:0] mix(input logic [63:0] x, input logic [511:0] a,
+                                       input logic [511:0] b, input int lane);
+      logic [63:0] r = x;
+      for (int i = 0; i < 8; ++i) begin
+         r = r ^ a[(i * 64) +: 64] ^ 64'(lane);
+         r = (r << 7) ^ (r >> 3) ^ b[(((i + lane) % 8) * 64) +: 64];
+      end
+      return r;
+   endfunction
+
+   genvar g;
+   generate
+      for (g = 0; g < LANES; ++g) begin : lane
+         logic [63:0] q = 64'(g);
+         logic [63:0] d;
+         // Each lane reads both tables, and lanes share table entries
+         always_comb d = mix(q, tbl_a[4'(cyc + g)], tbl_b[4'(cyc + 2 * g)], g);
+         assign lane_d[g] = d;
+         always @(posedge clk) q <= d;
+      end
+   endgenerate
+
+   // Reference of all lanes in one process
+   logic [63:0] ref_q [LANES];
+   initial for (int i = 0; i < LANES; ++i) ref_q[i] = 64'(i);
+
+   always @(posedge clk) begin
+      for (int i = 0; i < LANES; ++i) begin
+         if (lane_d[i] != mix(ref_q[i], tbl_a[4'(cyc + i)], tbl_b[4'(cyc + 2 * i)], i)) begin
+            $write("%%Error: lane %0d mismatch at cyc %0d\n", i, cyc);
+            $stop;
+         end
+         ref_q[i] <= lane_d[i];
+      end
+      tbl_a[4'(cyc)] <= tbl_a[4'(cyc)] ^ {8{lane_d[4'(cyc % LANES)]}};
+      cyc <= cyc + 1;
+      if (cyc == 100) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
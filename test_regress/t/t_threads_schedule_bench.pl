@@ -0,0 +1,45 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+# Compare static and dynamic thread scheduling on a design with skewed
+# mtask costs. Use 'driver.pl --benchmark' for a meaningful run length;
+# results are in the benchmarksim .csv file, one line per schedule.
+
+scenarios(vltmt => 1);
+
+top_filename("t/t_threads_schedule_dynamic.v");
+
+init_benchmarksim();
+
+my @schedules = ("static", "dynamic");
+
+foreach my $schedule (@schedules) {
+    compile(
+        benchmarksim => 1,
+        verilator_flags2 => ["--threads-schedule $schedule"],
+        threads => 4,
+        );
+
+    execute(
+        check_finished => 1,
+        );
+}
+
+my $fh = IO::File->new("<" . benchmarksim_filename()) or error("Benchmark data file not found");
+my $lines = 0;
+while (defined(my $line = $fh->getline)) {
+    next if $line =~ /^#/;
+    $lines += 1;
+}
+error("Expected " . (scalar(@schedules) + 1) . " lines but found " . $lines)
+    if $lines != scalar(@schedules) + 1;
+
+ok(1);
+1;
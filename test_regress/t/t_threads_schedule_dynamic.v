@@ -0,0 +1,73 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Lanes with very different, data dependent evaluation costs, so a static
+// thread schedule is unbalanced.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   localparam LANES = 8;
+   localparam last_cyc =
+`ifdef TEST_BENCHMARK
+              `TEST_BENCHMARK * 1000;
+`else
+   100;
+`endif
+
+   function automatic logic [63:0] mix(input logic [63:0] x, input int rounds);
+      logic [63:0] r = x;
+      for (int i = 0; i < rounds; ++i) begin
+         r = r ^ (r << 13);
+         r = r ^ (r >> 7);
+         r = r ^ (r << 17);
+      end
+      return r;
+   endfunction
+
+   integer cyc = 0;
+   logic [63:0] sum;
+
+   logic [63:0] lane_d [LANES];
+
+   genvar g;
+   generate
+      for (g = 0; g < LANES; ++g) begin : lane
+         logic [63:0] q = 64'h1234_5678_9abc_def0 + 64'(g);
+         logic [63:0] d;
+         // Cost depends both on the lane and on the data
+         always_comb d = q[0] ? mix(q, (g + 1) * (g + 1) * 4) : mix(q, g + 1);
+         assign lane_d[g] = d;
+         always @(posedge clk) begin
+            q <= d;
+            if (d != (q[0] ? mix(q, (g + 1) * (g + 1) * 4) : mix(q, g + 1))) begin
+               $write("%%Error: lane %0d mismatch at cyc %0d\n", g, cyc);
+               $stop;
+            end
+         end
+      end
+   endgenerate
+
+   always_comb begin
+      sum = 0;
+      for (int i = 0; i < LANES; ++i) sum = sum ^ lane_d[i];
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d sum=%x\n", $time, cyc, sum);
+`endif
+      if (cyc == last_cyc) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,69 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Many contexts sharing one set of simulation threads
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+#include <verilated_threads.h>
+
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include VM_PREFIX_INCLUDE
+
+double sc_time_stamp() { return 0; }
+
+int errors = 0;
+
+static const int CONTEXTS = 6;
+
+static void sim(VM_PREFIX* topp) {
+    VerilatedContext* const contextp = topp->contextp();
+    // This test created a thread, so need to associate VerilatedContext with it
+    Verilated::threadContextp(contextp);
+    topp->clk = 0;
+    topp->eval();
+    while (!contextp->gotFinish()) {
+        contextp->timeInc(1);
+        topp->clk = !topp->clk;
+        topp->eval();
+    }
+    topp->final();
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::unique_ptr<VerilatedContext>> contexts;
+    std::vector<std::unique_ptr<VM_PREFIX>> tops;
+    for (int i = 0; i < CONTEXTS; ++i) {
+        contexts.emplace_back(new VerilatedContext);
+        VerilatedContext* const contextp = contexts.back().get();
+        contextp->commandArgs(argc, argv);
+        contextp->threadsShared(true);
+        contextp->threads(3);  // Quota of this context
+        const std::string name = "top" + std::to_string(i);
+        tops.emplace_back(new VM_PREFIX{contextp, name.c_str()});
+    }
+
+    // All pools draw on the same process-wide threads
+    for (const auto& contextp : contexts) {
+        VlThreadPool* const poolp = static_cast<VlThreadPool*>(contextp->threadPoolp());
+        TEST_CHECK_EQ(poolp->shared(), true);
+        TEST_CHECK_EQ(poolp->numThreads(), 2);
+    }
+
+    std::vector<std::thread> threads;
+    for (const auto& topp : tops) threads.emplace_back(sim, topp.get());
+    for (std::thread& thread : threads) thread.join();
+
+    for (const auto& contextp : contexts) TEST_CHECK_EQ(contextp->gotFinish(), true);
+    return errors ? 10 : 0;
+}
@@ -0,0 +1,32 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vltmt => 1);
+
+top_filename("t/t_threads_schedule_dynamic.v");
+
+compile(
+    verilator_flags2 => ["--threads-var-layout --stats"],
+    threads => 4,
+    );
+
+if ($Self->{vlt_all}) {
+    file_grep($Self->{stats}, qr/Var layout, cross-thread shared cache lines before\s+(\d+)/i);
+    file_grep($Self->{stats}, qr/Var layout, cross-thread shared cache lines after\s+(\d+)/i);
+    file_grep_any([glob("$Self->{obj_dir}/$Self->{vm_prefix}*.h")],
+                  qr/alignas\(VL_CACHE_LINE_BYTES\) (VL_|[CSIQ]Data|VlWide)/);
+}
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
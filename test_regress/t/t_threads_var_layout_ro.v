@@ -0,0 +1,43 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// A table only read by clocked logic, which must be laid out with the
+// read-mostly variables.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   localparam LANES = 8;
+
+   integer cyc = 0;
+
+   // Written only by the initial block, read only by clocked logic
+   logic [31:0] rom [16];
+   initial for (int i = 0; i < 16; ++i) rom[i] = 32'(i) * 32'h9e37_79b9;
+
+   logic [31:0] acc [LANES];
+   initial for (int i = 0; i < LANES; ++i) acc[i] = 0;
+
+   genvar g;
+   generate
+      for (g = 0; g < LANES; ++g) begin : lane
+         always @(posedge clk) acc[g] <= (acc[g] << 1) ^ rom[4'(cyc + g)];
+      end
+   endgenerate
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 20) begin
+         if (acc[0] == acc[1]) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
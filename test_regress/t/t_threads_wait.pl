@@ -0,0 +1,36 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vltmt => 1);
+
+top_filename("t/t_threads_schedule_dynamic.v");
+
+compile(
+    verilator_flags2 => ["--prof-exec"],
+    threads => 4,
+    );
+
+foreach my $policy ("spin-yield", "park", "adaptive") {
+    execute(
+        all_run_flags => ["+verilator+threads+wait+$policy",
+                          " +verilator+prof+exec+file+$Self->{obj_dir}/profile_exec_$policy.dat"],
+        check_finished => 1,
+        );
+    file_grep("$Self->{obj_dir}/profile_exec_$policy.dat", qr/VLPROF stat parks \d+/);
+}
+
+execute(
+    all_run_flags => ["+verilator+threads+wait+bogus"],
+    fails => 1,
+    expect => qr/Unknown \+verilator\+threads\+wait\+ policy: 'bogus'/,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,43 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   int cyc = 0;
+   int forks = 0;
+   int waits = 0;
+
+   // Each call suspends, so gets its own coroutine frame
+   task automatic wait_cycles(int n);
+      repeat (n) @(posedge clk);
+   endtask
+
+   initial forever begin
+      wait_cycles(2);
+      waits++;
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      // A new process every cycle, its frame is freed when it finishes
+      fork
+         #1 forks++;
+      join_none
+      if (cyc == 99) begin
+`ifdef TEST_VERBOSE
+         $write("[%0t] forks=%0d waits=%0d\n", $time, forks, waits);
+`endif
+         if (forks < 90) $stop;
+         if (waits < 45) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
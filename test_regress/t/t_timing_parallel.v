@@ -0,0 +1,48 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+   logic clk_a = 0;
+   logic clk_b = 0;
+   logic clk_c = 0;
+   logic clk_d = 0;
+   int   cnt_a = 0;
+   int   cnt_b = 0;
+   int   cnt_c = 0;
+   int   cnt_d = 0;
+   int   shared = 0;
+
+   // Independent clock generators, resumed in parallel at common times
+   always #5 clk_a = ~clk_a;
+   always #10 clk_b = ~clk_b;
+   initial forever #5 clk_c = ~clk_c;
+   initial begin
+      repeat (100) #2 clk_d = ~clk_d;
+   end
+
+   // These two write the same variable, so only one can be resumed in parallel
+   initial repeat (10) #10 shared = shared + 1;
+   initial repeat (10) #10 shared = shared + 2;
+
+   always @(posedge clk_a) cnt_a <= cnt_a + 1;
+   always @(posedge clk_b) cnt_b <= cnt_b + 1;
+   always @(posedge clk_c) cnt_c <= cnt_c + 1;
+   always @(posedge clk_d) cnt_d <= cnt_d + 1;
+
+   initial begin
+      #1000;
+`ifdef TEST_VERBOSE
+      $write("%0d %0d %0d %0d %0d\n", cnt_a, cnt_b, cnt_c, cnt_d, shared);
+`endif
+      if (cnt_a != 100) $stop;
+      if (cnt_b != 50) $stop;
+      if (cnt_c != 100) $stop;
+      if (cnt_d != 50) $stop;
+      if (shared != 30) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,35 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+   int cnt[4];
+
+   // Instances of one module share their variables' declarations, but not
+   // their storage, so all clock generators are resumed in parallel
+   clkgen u0 (.cnt(cnt[0]));
+   clkgen u1 (.cnt(cnt[1]));
+   clkgen u2 (.cnt(cnt[2]));
+   clkgen u3 (.cnt(cnt[3]));
+
+   initial begin
+      #1000;
+`ifdef TEST_VERBOSE
+      $write("%0d %0d %0d %0d\n", cnt[0], cnt[1], cnt[2], cnt[3]);
+`endif
+      for (int i = 0; i < 4; ++i) if (cnt[i] != 100) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
+
+module clkgen (output int cnt);
+   /*verilator no_inline_module*/
+   logic clk = 0;
+
+   always #5 clk = ~clk;
+
+   always @(posedge clk) cnt <= cnt + 1;
+endmodule
@@ -0,0 +1,55 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+class Counter;
+   int count = 0;
+   task inc();
+      count++;
+   endtask
+   // Dynamic trigger depending only on 'count'
+   task wait_for(int n);
+      while (count < n) @(count);
+   endtask
+endclass
+
+class Pair;
+   bit a = 0;
+   bit b = 0;
+   // Dynamic trigger depending only on 'a' and 'b'
+   task wait_both();
+      wait(a && b);
+   endtask
+endclass
+
+module t;
+   Counter c = new;
+   Pair p = new;
+   int done = 0;
+
+   initial begin
+      fork
+         begin c.wait_for(3); if ($time != 30) $stop; done++; end
+         begin c.wait_for(5); if ($time != 50) $stop; done++; end
+         begin p.wait_both(); if ($time != 25) $stop; done++; end
+      join_none
+      repeat (5) begin
+         #10;
+         c.inc();
+      end
+   end
+
+   initial begin
+      #15 p.a = 1;
+      #10 p.b = 1;
+   end
+
+   initial begin
+      #100;
+      if (done != 3) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,42 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+# Compare the delay scheduler heap against the timing wheel on many
+# concurrent delays. Use 'driver.pl --benchmark' for a meaningful run length;
+# results are in the benchmarksim .csv file, one line per wheel size.
+
+scenarios(vlt => 1);
+
+init_benchmarksim();
+
+my @wheels = (0, 64, 1024);
+
+foreach my $wheel (@wheels) {
+    compile(
+        benchmarksim => 1,
+        verilator_flags2 => ["--timing --timing-wheel $wheel"],
+        );
+
+    execute(
+        check_finished => 1,
+        );
+}
+
+my $fh = IO::File->new("<" . benchmarksim_filename()) or error("Benchmark data file not found");
+my $lines = 0;
+while (defined(my $line = $fh->getline)) {
+    next if $line =~ /^#/;
+    $lines += 1;
+}
+error("Expected " . (scalar(@wheels) + 1) . " lines but found " . $lines)
+    if $lines != scalar(@wheels) + 1;
+
+ok(1);
+1;
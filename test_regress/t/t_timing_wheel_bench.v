@@ -0,0 +1,50 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`ifdef TEST_BENCHMARK
+ `define ROUNDS (`TEST_BENCHMARK * 100)
+`else
+ `define ROUNDS 100
+`endif
+
+module t;
+   localparam PROCS = 512;
+   localparam LONG_DELAY = 1000;  // Beyond the wheel horizon
+
+   int count[PROCS];
+   int long_count = 0;
+
+   // Many concurrent processes with short delays, all kept in the wheel
+   for (genvar i = 0; i < PROCS; ++i) begin : gen_proc
+      initial begin
+         repeat (`ROUNDS) begin
+            #(i % 7 + 1);
+            count[i]++;
+            if (i % 64 == 0) #0 count[i]++;  // Zero delays resume in the same time slot
+         end
+      end
+   end
+
+   // A few long delays, these overflow into the heap
+   for (genvar i = 0; i < 4; ++i) begin : gen_long
+      initial begin
+         repeat (`ROUNDS * 8 / LONG_DELAY + 1) #(LONG_DELAY + i) long_count++;
+      end
+   end
+
+   initial begin
+      #(`ROUNDS * 8 + LONG_DELAY * 2);
+      for (int i = 0; i < PROCS; ++i) begin
+         if (count[i] != (i % 64 == 0 ? 2 : 1) * `ROUNDS) begin
+            $write("%%Error: count[%0d] = %0d\n", i, count[i]);
+            $stop;
+         end
+      end
+      if (long_count != 4 * (`ROUNDS * 8 / LONG_DELAY + 1)) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
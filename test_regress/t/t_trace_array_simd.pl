@@ -0,0 +1,35 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+compile(
+    verilator_flags2 => ['--cc --trace'],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+if ($Self->{vlt_all}) {
+    my @files = glob_all("$Self->{obj_dir}/V$Self->{name}__Trace__*.cpp");
+    file_grep_any(\@files, qr/chgBitArray\(oldp\+\d+,&\([^)]*bits\[0\]\),11\)/);
+    file_grep_any(\@files, qr/chgCDataArray\(oldp\+\d+,&\([^)]*bytes\[0\]\),9,7\)/);
+    file_grep_any(\@files, qr/chgSDataArray\(oldp\+\d+,&\([^)]*shorts\[0\]\),5,13\)/);
+    file_grep_any(\@files, qr/chgIDataArray\(oldp\+\d+,&\([^)]*words\[0\]\),19,32\)/);
+}
+
+file_grep($Self->trace_filename, qr/^b1011010 /m);
+file_grep($Self->trace_filename, qr/^b1101001011100 /m);
+file_grep($Self->trace_filename, qr/^b11011110101011011011111011101111 /m);
+file_grep($Self->trace_filename, qr/^b11001010111111101111000000001101 /m);
+
+ok(1);
+1;
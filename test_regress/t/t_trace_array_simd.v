@@ -0,0 +1,30 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (clk);
+   input clk;
+   integer      cyc = 0;
+
+   // Arrays long enough to compare the previous values in blocks, with a
+   // tail that is not a multiple of the block size
+   bit          bits[11];
+   logic [6:0]  bytes[9];
+   logic [12:0] shorts[5];
+   logic [31:0] words[19];
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      bits[cyc % 11] <= ~bits[cyc % 11];
+      if (cyc == 2) bytes[8] <= 7'h5a;
+      if (cyc == 3) shorts[4] <= 13'h1a5c;
+      if (cyc == 4) words[17] <= 32'hdeadbeef;
+      if (cyc == 5) words[3] <= 32'hcafef00d;
+      if (cyc == 9) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,38 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(simulator => 1);
+
+top_filename("t/t_trace_complex.v");
+
+compile(
+    verilator_flags2 => ['--cc --trace-bin'],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+run(cmd => ["$ENV{VERILATOR_ROOT}/bin/verilator_trace_convert",
+            $Self->trace_filename,
+            "-o $Self->{obj_dir}/simx.vcd"],
+    );
+run(cmd => ["$ENV{VERILATOR_ROOT}/bin/verilator_trace_convert",
+            "--fst",
+            $Self->trace_filename,
+            "-o $Self->{obj_dir}/simx.fst"],
+    );
+
+# The FST holds the same waveform as the converted VCD, checked when
+# GTKWave's fst2vcd is installed
+fst_identical("$Self->{obj_dir}/simx.fst", "$Self->{obj_dir}/simx.vcd");
+
+ok(1);
+1;
@@ -0,0 +1,20 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (clk);
+   input clk;
+   integer      cyc = 0;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      // Writes the recorded dumps before this edge
+      if (cyc == 20) $dumpflush;
+      if (cyc == 30) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
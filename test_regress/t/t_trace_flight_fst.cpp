@@ -0,0 +1,43 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_fst_c.h>
+
+#include <memory>
+
+#include VM_PREFIX_INCLUDE
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->debug(0);
+    contextp->traceEverOn(true);
+    contextp->commandArgs(argc, argv);
+
+    const std::unique_ptr<VM_PREFIX> top{new VM_PREFIX{contextp.get(), "top"}};
+
+    std::unique_ptr<VerilatedFstC> tfp{new VerilatedFstC};
+    top->trace(tfp.get(), 99);
+    // Only keep the last 5 dumps in memory
+    tfp->flightRecorder(5);
+    tfp->open(VL_STRINGIFY(TEST_OBJ_DIR) "/simx.fst");
+
+    top->clk = 0;
+    while (!contextp->gotFinish()) {
+        top->clk = !top->clk;
+        top->eval();
+        tfp->dump(contextp->time());
+        contextp->timeInc(1);
+    }
+    // Only flightFlush or $dumpflush write the recorded dumps, not flush
+    tfp->flush();
+    // Discards the dumps after the last $dumpflush
+    tfp->close();
+    top->final();
+    return 0;
+}
@@ -0,0 +1,37 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+
+top_filename("t/t_trace_flight.v");
+
+compile(
+    make_top_shell => 0,
+    make_main => 0,
+    v_flags2 => ["--trace-fst --exe $Self->{t_dir}/$Self->{name}.cpp"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+my $vcd = "$Self->{obj_dir}/simx.vcd";
+fst2vcd("$Self->{obj_dir}/simx.fst", $vcd);
+if (!$Self->skips) {
+    # Only the 5 dumps before $dumpflush, starting with all values
+    file_grep_not($vcd, qr/^#34$/m);
+    file_grep($vcd, qr/^#35$/m);
+    file_grep($vcd, qr/^b00000000000000000000000000010010 /m);
+    file_grep($vcd, qr/^#39$/m);
+    file_grep_not($vcd, qr/^#40$/m);
+}
+
+ok(1);
+1;
@@ -0,0 +1,62 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_fst_c.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include VM_PREFIX_INCLUDE
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->debug(0);
+    contextp->traceEverOn(true);
+    contextp->commandArgs(argc, argv);
+
+    // +pack+<lz4|fastlz|zlib> +pack_threads+<n>
+    std::string packer = contextp->commandArgsPlusMatch("pack+");
+    packer = packer.empty() ? "lz4" : packer.substr(std::strlen("+pack+"));
+    const std::string threadsArg = contextp->commandArgsPlusMatch("pack_threads+");
+    const int threads
+        = threadsArg.empty() ? 1 : std::atoi(threadsArg.c_str() + std::strlen("+pack_threads+"));
+    const std::string filename = std::string{VL_STRINGIFY(TEST_OBJ_DIR) "/simx_"} + packer + "_"
+                                 + std::to_string(threads) + ".fst";
+
+    const std::unique_ptr<VM_PREFIX> top{new VM_PREFIX{contextp.get(), "top"}};
+
+    std::unique_ptr<VerilatedFstC> tfp{new VerilatedFstC};
+    top->trace(tfp.get(), 99);
+    tfp->packType(packer == "zlib"     ? FST_WR_PT_ZLIB
+                  : packer == "fastlz" ? FST_WR_PT_FASTLZ
+                                       : FST_WR_PT_LZ4);
+    tfp->packThreads(threads);
+
+    const auto start = std::chrono::steady_clock::now();
+    tfp->open(filename.c_str());
+    top->clk = 0;
+    while (!contextp->gotFinish()) {
+        top->clk = !top->clk;
+        top->eval();
+        tfp->dump(contextp->time());
+        contextp->timeInc(1);
+    }
+    tfp->close();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    top->final();
+
+    std::ifstream in{filename, std::ios::binary | std::ios::ate};
+    std::ofstream csv{VL_STRINGIFY(TEST_OBJ_DIR) "/pack_bench.csv", std::ios::app};
+    csv << packer << ", " << threads << ", " << in.tellg() << ", " << elapsed.count() << "\n";
+    return 0;
+}
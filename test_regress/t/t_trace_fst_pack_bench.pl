@@ -0,0 +1,56 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+# Compare FST file size and trace time across packers and packing thread
+# counts. Use 'driver.pl --benchmark' for a meaningful run length; results
+# are in pack_bench.csv, one line per configuration.
+
+scenarios(vlt => 1);
+
+top_filename("t/t_trace_parallel_bench.v");
+
+compile(
+    make_top_shell => 0,
+    make_main => 0,
+    verilator_flags2 => ["--exe $Self->{t_dir}/$Self->{name}.cpp --trace-fst --trace-max-array 64"],
+    );
+
+my $csv = "$Self->{obj_dir}/pack_bench.csv";
+write_wholefile($csv, "packer, threads, bytes, time[s]\n");
+
+my @configs;
+foreach my $packer ("lz4", "fastlz", "zlib") {
+    foreach my $threads (1, 2, 4) {
+        push @configs, [$packer, $threads];
+    }
+}
+
+foreach my $config (@configs) {
+    my ($packer, $threads) = @$config;
+    execute(
+        all_run_flags => ["+pack+$packer", "+pack_threads+$threads"],
+        check_finished => 1,
+        );
+}
+
+# All configurations must hold the same waveform
+fst2vcd("$Self->{obj_dir}/simx_lz4_1.fst", "$Self->{obj_dir}/simx_ref.vcd");
+foreach my $config (@configs) {
+    my ($packer, $threads) = @$config;
+    fst_identical("$Self->{obj_dir}/simx_${packer}_${threads}.fst",
+                  "$Self->{obj_dir}/simx_ref.vcd");
+}
+
+my $lines = scalar(split(/\n/, file_contents($csv)));
+error("Expected " . (scalar(@configs) + 1) . " lines but found " . $lines)
+    if $lines != scalar(@configs) + 1;
+
+ok(1);
+1;
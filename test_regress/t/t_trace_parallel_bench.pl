@@ -0,0 +1,49 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2023 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+# Compare FST and VCD tracing of a design with many changing signals across
+# thread counts. Use 'driver.pl --benchmark' for a meaningful run length;
+# results are in the benchmarksim .csv file, one line per configuration.
+
+scenarios(vltmt => 1);
+
+init_benchmarksim();
+
+my @configs;
+foreach my $format ("--trace-fst", "--trace") {
+    foreach my $threads (1, 2, 4) {
+        push @configs, [$format, $threads];
+    }
+}
+
+foreach my $config (@configs) {
+    my ($format, $threads) = @$config;
+    compile(
+        benchmarksim => 1,
+        verilator_flags2 => ["$format --trace-max-array 64"],
+        threads => $threads,
+        );
+
+    execute(
+        check_finished => 1,
+        );
+}
+
+my $fh = IO::File->new("<" . benchmarksim_filename()) or error("Benchmark data file not found");
+my $lines = 0;
+while (defined(my $line = $fh->getline)) {
+    next if $line =~ /^#/;
+    $lines += 1;
+}
+error("Expected " . (scalar(@configs) + 1) . " lines but found " . $lines)
+    if $lines != scalar(@configs) + 1;
+
+ok(1);
+1;
@@ -0,0 +1,58 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`ifdef TEST_BENCHMARK
+ `define CYCLES (`TEST_BENCHMARK * 100)
+`else
+ `define CYCLES 100
+`endif
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   localparam UNITS = 64;
+
+   int cyc = 0;
+   logic [31:0] sum[UNITS];
+
+   // Many traced signals, most of which change every cycle
+   for (genvar i = 0; i < UNITS; ++i) begin : gen_unit
+      unit #(.SEED(i)) unit(.clk(clk), .sum(sum[i]));
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == `CYCLES) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module unit #(parameter SEED = 0) (
+   input clk,
+   output logic [31:0] sum
+   );
+   logic [31:0] state[16];
+   logic [95:0] wide[8];
+   logic flag[32];
+
+   initial for (int i = 0; i < 16; ++i) state[i] = SEED * 16 + i;
+
+   always @(posedge clk) begin
+      for (int i = 0; i < 16; ++i) state[i] <= state[i] * 1103515245 + 12345;
+      for (int i = 0; i < 8; ++i) wide[i] <= {state[2 * i], state[2 * i + 1], state[i]};
+      for (int i = 0; i < 32; ++i) flag[i] <= state[i % 16][i];
+   end
+
+   always_comb begin
+      sum = 0;
+      for (int i = 0; i < 16; ++i) sum = sum ^ state[i];
+   end
+endmodule
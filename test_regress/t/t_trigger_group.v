@@ -0,0 +1,41 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2023 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   logic [3:0] div = 0;
+   // Derived clocks, each firing in different cycles
+   logic [3:0] clks;
+   integer counts[4];
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      div <= div + 1;
+      if (cyc == 64) begin
+         if (counts[0] != 31 || counts[1] != 15 || counts[2] != 7 || counts[3] != 3) begin
+            $write("%%Error: counts %0d %0d %0d %0d\n",
+                   counts[0], counts[1], counts[2], counts[3]);
+            $stop;
+         end
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   always_comb clks = div;
+
+   initial for (int i = 0; i < 4; ++i) counts[i] = 0;
+
+   always @(negedge clks[0]) counts[0] <= counts[0] + 1;
+   always @(negedge clks[1]) counts[1] <= counts[1] + 1;
+   always @(negedge clks[2]) counts[2] <= counts[2] + 1;
+   always @(negedge clks[3]) counts[3] <= counts[3] + 1;
+endmodule